@@ -0,0 +1,794 @@
+﻿// GC 벤치마크
+// 시드로 만든 그래프 모양과 크기마다 수집 모드를 돌려 마크/스윕 처리량, 정지 시간 백분위, 최대 RSS 를 출력한다
+// 최대 RSS 는 리눅스에서 설정마다 되돌려 재고, 되돌릴 수 없는 환경에서는 프로세스 전체의 최댓값이다
+// ex) GCBenchmark --shapes chain,dag --objects 10k,1m --modes full,parallel --format csv
+// --benchmark alloc 이면 수집 대신 여러 스레드에서 동시에 NewGCObject 를 부르는 할당 처리량을 스레드 수별로 잰다
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "GCManager.h"
+#include "GCUtility.h"
+#include "GCObject.h"
+#include "TypeInfo.h"
+#include "Property.h"
+
+class BenchNode : public GCObject
+{
+	GENERATE_TYPE_INFO(BenchNode)
+		PROPERTY(mFirst)
+		PROPERTY(mSecond)
+		PROPERTY(mChildren)
+
+public:
+	GCObject* mFirst = nullptr;
+	GCObject* mSecond = nullptr;
+	std::vector<GCObject*> mChildren;
+};
+
+struct BenchmarkOptions
+{
+	std::vector<std::string> Shapes = { "chain", "fanout", "dag", "clusters", "arrays" };
+	std::vector<size_t> ObjectCounts = { 10000, 100000, 1000000 };
+	std::vector<std::string> Modes = { "full", "parallel", "incremental", "concurrent", "minor", "compact" };
+	uint64_t Seed = 1;
+	size_t Iterations = 3;
+	double GarbageRatio = 0.5; // 전체 객체 중 루트에서 닿지 않는 객체 비율, 살아있는 객체 사이에 섞어서 할당
+	size_t ThreadCount = 0; // 0 이면 GCSettings 기본값
+	int64_t SliceUs = 1000; // 증분, 동시 수집의 슬라이스 예산
+	bool bCsv = false;
+	bool bAllocation = false; // --benchmark alloc
+	std::vector<size_t> AllocationThreadCounts = { 1, 2, 4, 8, 16 };
+	size_t HeapReserveBytes = GCSettings().HeapReserveBytes;
+	bool bHugePages = false;
+};
+
+struct BenchmarkResult
+{
+	std::string Shape;
+	std::string Mode;
+	size_t ObjectCount = 0;
+	size_t LiveObjects = 0;
+	int64_t MarkUs = 0; // 반복 평균
+	int64_t SweepUs = 0;
+	int64_t LazySweepUs = 0; // 수집 뒤 FinishSweep 에 걸린 시간
+	double MarkObjectsPerSec = 0.0;
+	double SweepObjectsPerSec = 0.0;
+	std::vector<int64_t> PausesUs;
+	size_t PeakRssKb = 0;
+	size_t PeakCommittedBytes = 0; // 그래프를 다 만든 직후 GC 힙이 커밋한 바이트의 최댓값
+};
+
+namespace
+{
+	const int FANOUT_DEGREE = 64;
+	const size_t CLUSTER_SIZE = 64;
+	const size_t ARRAY_LENGTH = 4096;
+
+	// 10k, 1m 처럼 k, m 접미사 허용
+	size_t parseCount(const std::string& text)
+	{
+		char* end = nullptr;
+		double value = std::strtod(text.c_str(), &end);
+
+		if (*end == 'k' || *end == 'K')
+		{
+			value *= 1000.0;
+		}
+		else if (*end == 'm' || *end == 'M')
+		{
+			value *= 1000000.0;
+		}
+		else if (*end == 'g' || *end == 'G')
+		{
+			value *= 1000000000.0;
+		}
+
+		return static_cast<size_t>(value);
+	}
+
+	std::vector<std::string> splitList(const std::string& text)
+	{
+		std::vector<std::string> items;
+		std::stringstream stream(text);
+		std::string item;
+
+		while (std::getline(stream, item, ','))
+		{
+			if (!item.empty())
+			{
+				items.push_back(item);
+			}
+		}
+
+		return items;
+	}
+
+	void printUsage()
+	{
+		std::cout
+			<< "usage: GCBenchmark [options]\n"
+			<< "  --shapes chain,fanout,dag,clusters,arrays\n"
+			<< "  --objects 10k,100k,1m,10m\n"
+			<< "  --modes full,parallel,incremental,concurrent,minor,compact\n"
+			<< "  --seed N            graph seed (default 1)\n"
+			<< "  --iterations N      collections per configuration (default 3)\n"
+			<< "  --garbage R         unreachable fraction 0..1 (default 0.5)\n"
+			<< "  --threads N         GC worker threads (default hardware_concurrency / 2)\n"
+			<< "  --slice-us N        incremental/concurrent slice budget (default 1000)\n"
+			<< "  --format json|csv   one JSON object per line, or CSV with a header (default json)\n"
+			<< "  --benchmark collect|alloc\n"
+			<< "                      alloc: allocate --objects garbage nodes split across threads (default collect)\n"
+			<< "  --alloc-threads 1,2,4,8,16\n"
+			<< "                      allocating thread counts for --benchmark alloc\n"
+			<< "  --heap-reserve N    virtual range reserved up front, k/m/g suffix, 0 disables (default 16g on 64-bit)\n"
+			<< "  --huge-pages 0|1    madvise(MADV_HUGEPAGE) on the reserved range, Linux only (default 0)\n";
+	}
+
+	bool parseOptions(int argc, char** argv, BenchmarkOptions& outOptions)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string option = argv[i];
+
+			if (option == "--help" || option == "-h" || i + 1 >= argc)
+			{
+				return false;
+			}
+
+			const std::string value = argv[++i];
+
+			if (option == "--shapes")
+			{
+				outOptions.Shapes = splitList(value);
+			}
+			else if (option == "--objects")
+			{
+				outOptions.ObjectCounts.clear();
+
+				for (const std::string& count : splitList(value))
+				{
+					outOptions.ObjectCounts.push_back(parseCount(count));
+				}
+			}
+			else if (option == "--modes")
+			{
+				outOptions.Modes = splitList(value);
+			}
+			else if (option == "--seed")
+			{
+				outOptions.Seed = std::strtoull(value.c_str(), nullptr, 10);
+			}
+			else if (option == "--iterations")
+			{
+				outOptions.Iterations = std::max<size_t>(1, parseCount(value));
+			}
+			else if (option == "--garbage")
+			{
+				outOptions.GarbageRatio = std::clamp(std::strtod(value.c_str(), nullptr), 0.0, 0.95);
+			}
+			else if (option == "--threads")
+			{
+				outOptions.ThreadCount = parseCount(value);
+			}
+			else if (option == "--slice-us")
+			{
+				outOptions.SliceUs = std::max<int64_t>(1, static_cast<int64_t>(parseCount(value)));
+			}
+			else if (option == "--format")
+			{
+				outOptions.bCsv = (value == "csv");
+			}
+			else if (option == "--benchmark")
+			{
+				outOptions.bAllocation = (value == "alloc");
+			}
+			else if (option == "--alloc-threads")
+			{
+				outOptions.AllocationThreadCounts.clear();
+
+				for (const std::string& count : splitList(value))
+				{
+					outOptions.AllocationThreadCounts.push_back(std::max<size_t>(1, parseCount(count)));
+				}
+			}
+			else if (option == "--heap-reserve")
+			{
+				outOptions.HeapReserveBytes = parseCount(value);
+			}
+			else if (option == "--huge-pages")
+			{
+				outOptions.bHugePages = (value != "0");
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// 리눅스에서 최대 RSS(VmHWM)를 지금 RSS 로 되돌린다, 지원하지 않거나 권한이 없으면 false
+	bool resetPeakRss()
+	{
+#ifdef __linux__
+		std::ofstream clearRefs("/proc/self/clear_refs");
+		clearRefs << "5";
+		clearRefs.flush();
+
+		return static_cast<bool>(clearRefs);
+#else
+		return false;
+#endif
+	}
+
+	// 설정을 시작할 때 부른다, 처음 실패했을 때 한 번만 알린다
+	void beginPeakRssScope()
+	{
+		static bool bWarned = false;
+
+		if (!resetPeakRss() && !bWarned)
+		{
+			std::cerr << "peak_rss_kb can not be reset on this platform, it reports the process-wide peak\n";
+			bWarned = true;
+		}
+	}
+
+	size_t getPeakRssKb()
+	{
+#ifdef __linux__
+		std::ifstream status("/proc/self/status");
+		std::string line;
+
+		while (std::getline(status, line))
+		{
+			if (line.compare(0, 6, "VmHWM:") == 0)
+			{
+				return std::strtoull(line.c_str() + 6, nullptr, 10);
+			}
+		}
+#endif
+
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters = {};
+		GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+		return counters.PeakWorkingSetSize / 1024;
+#else
+		rusage usage = {};
+		getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+		return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+		return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#endif
+	}
+
+	int64_t percentile(const std::vector<int64_t>& sortedValues, size_t percent)
+	{
+		if (sortedValues.empty())
+		{
+			return 0;
+		}
+
+		return sortedValues[(sortedValues.size() - 1) * percent / 100];
+	}
+}
+
+// 살아있는 노드 사이사이에 어디서도 참조하지 않는 노드를 끼워 넣어 같은 페이지에 섞이게 한다
+class GraphBuilder final
+{
+public:
+	GraphBuilder(size_t objectCount, double garbageRatio, uint64_t seed)
+		: mRandom(seed)
+		, mGarbageCount(static_cast<size_t>(objectCount * garbageRatio))
+		, mLiveCount(std::max<size_t>(1, objectCount - mGarbageCount))
+	{
+	}
+
+	// 루트 하나를 돌려준다, 호출자가 SetRoot 한다
+	BenchNode* Build(const std::string& shape)
+	{
+		if (shape == "chain")
+		{
+			return buildChain();
+		}
+		if (shape == "fanout")
+		{
+			return buildFanout();
+		}
+		if (shape == "dag")
+		{
+			return buildDag();
+		}
+		if (shape == "clusters")
+		{
+			return buildClusters();
+		}
+		if (shape == "arrays")
+		{
+			return buildArrays();
+		}
+
+		return nullptr;
+	}
+
+	size_t GetLiveCount() const { return mLiveCount; }
+
+private:
+	BenchNode* newNode()
+	{
+		BenchNode* node = NewGCObject<BenchNode>(GCManager::Get());
+		++mAllocatedLive;
+
+		while (mAllocatedGarbage * mLiveCount < mAllocatedLive * mGarbageCount)
+		{
+			NewGCObject<BenchNode>(GCManager::Get());
+			++mAllocatedGarbage;
+		}
+
+		return node;
+	}
+
+	size_t randomIndex(size_t bound)
+	{
+		return static_cast<size_t>(mRandom() % bound);
+	}
+
+	static void addChild(BenchNode* parent, GCObject* child)
+	{
+		GC_WRITE_BARRIER(parent, child);
+		parent->mChildren.push_back(child);
+	}
+
+	// mFirst 로 이어진 긴 연결 리스트
+	BenchNode* buildChain()
+	{
+		BenchNode* head = newNode();
+		BenchNode* tail = head;
+
+		for (size_t i = 1; i < mLiveCount; ++i)
+		{
+			BenchNode* next = newNode();
+			GC_STORE(tail, mFirst, next);
+			tail = next;
+		}
+
+		return head;
+	}
+
+	// 노드마다 자식 FANOUT_DEGREE 개인 넓은 트리
+	BenchNode* buildFanout()
+	{
+		std::vector<BenchNode*> nodes;
+		nodes.reserve(mLiveCount);
+		nodes.push_back(newNode());
+
+		for (size_t i = 1; i < mLiveCount; ++i)
+		{
+			nodes.push_back(newNode());
+			addChild(nodes[(i - 1) / FANOUT_DEGREE], nodes[i]);
+		}
+
+		return nodes[0];
+	}
+
+	// 앞쪽 노드에서 뒤쪽 노드로만 향하는 무작위 DAG, 부모 간선 하나와 추가 간선 하나
+	BenchNode* buildDag()
+	{
+		std::vector<BenchNode*> nodes;
+		nodes.reserve(mLiveCount);
+		nodes.push_back(newNode());
+
+		for (size_t i = 1; i < mLiveCount; ++i)
+		{
+			nodes.push_back(newNode());
+			addChild(nodes[randomIndex(i)], nodes[i]);
+		}
+
+		for (size_t i = 0; i + 1 < mLiveCount; ++i)
+		{
+			GC_STORE(nodes[i], mFirst, nodes[i + 1 + randomIndex(mLiveCount - i - 1)]);
+		}
+
+		return nodes[0];
+	}
+
+	// mFirst 로 닫힌 고리와 mSecond 로 고리 안의 무작위 노드를 가리키는 클러스터, 루트가 클러스터 머리를 모두 가진다
+	BenchNode* buildClusters()
+	{
+		BenchNode* root = newNode();
+		std::vector<BenchNode*> cluster;
+		cluster.reserve(CLUSTER_SIZE);
+
+		for (size_t begin = 1; begin < mLiveCount; begin += CLUSTER_SIZE)
+		{
+			const size_t size = std::min(CLUSTER_SIZE, mLiveCount - begin);
+			cluster.clear();
+
+			for (size_t i = 0; i < size; ++i)
+			{
+				cluster.push_back(newNode());
+			}
+
+			for (size_t i = 0; i < size; ++i)
+			{
+				GC_STORE(cluster[i], mFirst, cluster[(i + 1) % size]);
+				GC_STORE(cluster[i], mSecond, cluster[randomIndex(size)]);
+			}
+
+			addChild(root, cluster[0]);
+		}
+
+		return root;
+	}
+
+	// 루트가 ARRAY_LENGTH 길이의 참조 배열을 가진 노드들을 가리킨다
+	BenchNode* buildArrays()
+	{
+		BenchNode* root = newNode();
+		BenchNode* array = nullptr;
+
+		for (size_t i = 1; i < mLiveCount; ++i)
+		{
+			if (array == nullptr || array->mChildren.size() == ARRAY_LENGTH)
+			{
+				array = newNode();
+				array->mChildren.reserve(ARRAY_LENGTH);
+				addChild(root, array);
+				continue;
+			}
+
+			addChild(array, newNode());
+		}
+
+		return root;
+	}
+
+private:
+	std::mt19937_64 mRandom;
+	size_t mGarbageCount = 0;
+	size_t mLiveCount = 0;
+	size_t mAllocatedLive = 0;
+	size_t mAllocatedGarbage = 0;
+};
+
+// 모드 하나로 한 사이클을 끝까지 수집하고 이번 사이클의 정지 시간을 pauses 에 더한다
+bool collect(const std::string& mode, int64_t sliceUs, std::vector<int64_t>& pauses)
+{
+	GCManager& gcManager = GCManager::Get();
+	const GCDebugInfo& lastInfo = gcManager.GetLastDebugInfo();
+
+	if (mode == "full")
+	{
+		gcManager.Collect();
+	}
+	else if (mode == "parallel")
+	{
+		gcManager.CollectMultiThread();
+	}
+	else if (mode == "minor")
+	{
+		gcManager.CollectMinor();
+	}
+	else if (mode == "compact")
+	{
+		gcManager.CollectCompact();
+	}
+	else if (mode == "incremental" || mode == "concurrent")
+	{
+		do
+		{
+			if (mode == "incremental")
+			{
+				gcManager.CollectIncremental(sliceUs);
+			}
+			else
+			{
+				gcManager.CollectConcurrent(sliceUs);
+				// 배경 마킹 중에는 변경자가 한 프레임 일하는 것으로 친다
+				std::this_thread::sleep_for(std::chrono::microseconds(sliceUs));
+			}
+		} while (gcManager.IsIncrementalCollecting());
+
+		pauses.insert(pauses.end(), lastInfo.SlicePausesUs.begin(), lastInfo.SlicePausesUs.end());
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+
+	pauses.push_back(lastInfo.DurationUs);
+	return true;
+}
+
+bool runBenchmark(const BenchmarkOptions& options, const std::string& shape, size_t objectCount, const std::string& mode, BenchmarkResult& outResult)
+{
+	GCManager& gcManager = GCManager::Get();
+	const GCDebugInfo& lastInfo = gcManager.GetLastDebugInfo();
+
+	size_t markedObjects = 0;
+	size_t sweptObjects = 0;
+	int64_t totalMarkUs = 0;
+	int64_t totalSweepUs = 0;
+	int64_t totalLazySweepUs = 0;
+
+	outResult = BenchmarkResult();
+	outResult.Shape = shape;
+	outResult.Mode = mode;
+	outResult.ObjectCount = objectCount;
+
+	beginPeakRssScope();
+
+	for (size_t iteration = 0; iteration < options.Iterations; ++iteration)
+	{
+		// 모드와 반복이 달라도 같은 시드면 같은 그래프
+		GraphBuilder builder(objectCount, options.GarbageRatio, options.Seed);
+		BenchNode* root = builder.Build(shape);
+
+		if (root == nullptr)
+		{
+			return false;
+		}
+
+		root->SetRoot(true);
+		outResult.LiveObjects = builder.GetLiveCount();
+		outResult.PeakCommittedBytes = std::max(outResult.PeakCommittedBytes, gcManager.GetCommittedBytes());
+
+		if (!collect(mode, options.SliceUs, outResult.PausesUs))
+		{
+			root->SetRoot(false);
+			gcManager.Collect();
+			gcManager.FinishSweep();
+			return false;
+		}
+
+		markedObjects += lastInfo.RemainingObjects;
+		sweptObjects += lastInfo.TotalObjects;
+		totalMarkUs += lastInfo.RootScanUs + lastInfo.MarkUs + lastInfo.ConcurrentMarkUs;
+		totalSweepUs += lastInfo.SweepUs;
+
+		const auto lazySweepStart = std::chrono::high_resolution_clock::now();
+		gcManager.FinishSweep();
+		totalLazySweepUs += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - lazySweepStart).count();
+
+		root->SetRoot(false);
+		gcManager.Collect();
+		gcManager.FinishSweep();
+	}
+
+	const int64_t iterations = static_cast<int64_t>(options.Iterations);
+
+	outResult.MarkUs = totalMarkUs / iterations;
+	outResult.SweepUs = totalSweepUs / iterations;
+	outResult.LazySweepUs = totalLazySweepUs / iterations;
+	outResult.MarkObjectsPerSec = markedObjects * 1e6 / std::max<int64_t>(1, totalMarkUs);
+	outResult.SweepObjectsPerSec = sweptObjects * 1e6 / std::max<int64_t>(1, totalSweepUs + totalLazySweepUs);
+	outResult.PeakRssKb = getPeakRssKb();
+
+	return true;
+}
+
+void printResult(const BenchmarkOptions& options, const BenchmarkResult& result)
+{
+	std::vector<int64_t> pauses = result.PausesUs;
+	std::sort(pauses.begin(), pauses.end());
+
+	const size_t threadCount = GCManager::Get().GetWorkerThreadCount();
+
+	if (options.bCsv)
+	{
+		std::cout << result.Shape << ',' << result.ObjectCount << ',' << result.LiveObjects << ',' << result.Mode << ','
+			<< threadCount << ',' << options.Seed << ',' << options.Iterations << ','
+			<< result.MarkUs << ',' << result.SweepUs << ',' << result.LazySweepUs << ','
+			<< static_cast<uint64_t>(result.MarkObjectsPerSec) << ',' << static_cast<uint64_t>(result.SweepObjectsPerSec) << ','
+			<< pauses.size() << ',' << percentile(pauses, 50) << ',' << percentile(pauses, 95) << ','
+			<< percentile(pauses, 99) << ',' << (pauses.empty() ? 0 : pauses.back()) << ','
+			<< result.PeakRssKb << ',' << result.PeakCommittedBytes << ',' << GCManager::Get().GetReservedBytes() << '\n';
+		return;
+	}
+
+	std::cout << "{\"shape\":\"" << result.Shape << "\""
+		<< ",\"objects\":" << result.ObjectCount
+		<< ",\"live_objects\":" << result.LiveObjects
+		<< ",\"mode\":\"" << result.Mode << "\""
+		<< ",\"threads\":" << threadCount
+		<< ",\"seed\":" << options.Seed
+		<< ",\"iterations\":" << options.Iterations
+		<< ",\"mark_us\":" << result.MarkUs
+		<< ",\"sweep_us\":" << result.SweepUs
+		<< ",\"lazy_sweep_us\":" << result.LazySweepUs
+		<< ",\"mark_objects_per_sec\":" << static_cast<uint64_t>(result.MarkObjectsPerSec)
+		<< ",\"sweep_objects_per_sec\":" << static_cast<uint64_t>(result.SweepObjectsPerSec)
+		<< ",\"pause_count\":" << pauses.size()
+		<< ",\"pause_p50_us\":" << percentile(pauses, 50)
+		<< ",\"pause_p95_us\":" << percentile(pauses, 95)
+		<< ",\"pause_p99_us\":" << percentile(pauses, 99)
+		<< ",\"pause_max_us\":" << (pauses.empty() ? 0 : pauses.back())
+		<< ",\"peak_rss_kb\":" << result.PeakRssKb
+		<< ",\"peak_committed_bytes\":" << result.PeakCommittedBytes
+		<< ",\"reserved_bytes\":" << GCManager::Get().GetReservedBytes()
+		<< "}\n";
+}
+
+// threadCount 개의 스레드가 objectCount 개를 나눠 할당하는 데 걸린 시간, 할당한 객체는 모두 쓰레기
+// 등록 블록 병합과 해제는 이어지는 수집에서 일어나며 collectUs 로 따로 돌려준다
+int64_t runAllocation(size_t objectCount, size_t threadCount, int64_t& outCollectUs)
+{
+	std::atomic<size_t> readyCount = 0;
+	std::atomic<bool> bStart = false;
+	std::vector<std::thread> threads;
+
+	for (size_t t = 0; t < threadCount; ++t)
+	{
+		const size_t count = objectCount / threadCount + (t < objectCount % threadCount ? 1 : 0);
+
+		threads.emplace_back([count, &readyCount, &bStart]() {
+			// 캐시를 가져오는 첫 할당은 시간에 넣지 않는다
+			NewGCObject<BenchNode>(GCManager::Get());
+			readyCount.fetch_add(1, std::memory_order_release);
+
+			while (!bStart.load(std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+			}
+
+			for (size_t i = 1; i < count; ++i)
+			{
+				NewGCObject<BenchNode>(GCManager::Get());
+			}
+			});
+	}
+
+	while (readyCount.load(std::memory_order_acquire) != threadCount)
+	{
+		std::this_thread::yield();
+	}
+
+	const auto start = std::chrono::high_resolution_clock::now();
+	bStart.store(true, std::memory_order_release);
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	const int64_t elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+	const auto collectStart = std::chrono::high_resolution_clock::now();
+	GCManager::Get().Collect();
+	GCManager::Get().FinishSweep();
+	outCollectUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - collectStart).count();
+
+	return elapsedUs;
+}
+
+void runAllocationBenchmark(const BenchmarkOptions& options)
+{
+	if (options.bCsv)
+	{
+		std::cout << "benchmark,objects,alloc_threads,iterations,alloc_us,objects_per_sec,speedup,collect_us,peak_rss_kb\n";
+	}
+
+	for (size_t objectCount : options.ObjectCounts)
+	{
+		double baseObjectsPerSec = 0.0;
+
+		for (size_t threadCount : options.AllocationThreadCounts)
+		{
+			int64_t bestUs = 0;
+			int64_t collectUs = 0;
+
+			beginPeakRssScope();
+
+			// 스레드 생성과 스케줄링 편차가 커서 반복 중 가장 빠른 값을 쓴다
+			for (size_t iteration = 0; iteration < options.Iterations; ++iteration)
+			{
+				const int64_t elapsedUs = std::max<int64_t>(1, runAllocation(objectCount, threadCount, collectUs));
+				bestUs = (iteration == 0) ? elapsedUs : std::min(bestUs, elapsedUs);
+			}
+
+			const double objectsPerSec = objectCount * 1e6 / bestUs;
+			const size_t peakRssKb = getPeakRssKb();
+
+			if (baseObjectsPerSec == 0.0)
+			{
+				baseObjectsPerSec = objectsPerSec;
+			}
+
+			const double speedup = objectsPerSec / baseObjectsPerSec;
+
+			if (options.bCsv)
+			{
+				std::cout << "alloc," << objectCount << ',' << threadCount << ',' << options.Iterations << ','
+					<< bestUs << ',' << static_cast<uint64_t>(objectsPerSec) << ',' << speedup << ','
+					<< collectUs << ',' << peakRssKb << '\n';
+				continue;
+			}
+
+			std::cout << "{\"benchmark\":\"alloc\""
+				<< ",\"objects\":" << objectCount
+				<< ",\"alloc_threads\":" << threadCount
+				<< ",\"iterations\":" << options.Iterations
+				<< ",\"alloc_us\":" << bestUs
+				<< ",\"objects_per_sec\":" << static_cast<uint64_t>(objectsPerSec)
+				<< ",\"speedup\":" << speedup
+				<< ",\"collect_us\":" << collectUs
+				<< ",\"peak_rss_kb\":" << peakRssKb
+				<< "}\n";
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkOptions options;
+
+	if (!parseOptions(argc, argv, options))
+	{
+		printUsage();
+		return 1;
+	}
+
+	GCSettings settings;
+	settings.WorkerThreadCount = options.ThreadCount;
+	settings.HeapReserveBytes = options.HeapReserveBytes;
+	settings.bHugePages = options.bHugePages;
+	GCManager::Create(settings);
+
+	if (options.bAllocation)
+	{
+		runAllocationBenchmark(options);
+		GCManager::Destroy();
+		return 0;
+	}
+
+	if (options.bCsv)
+	{
+		std::cout << "shape,objects,live_objects,mode,threads,seed,iterations,mark_us,sweep_us,lazy_sweep_us,"
+			<< "mark_objects_per_sec,sweep_objects_per_sec,pause_count,pause_p50_us,pause_p95_us,pause_p99_us,pause_max_us,peak_rss_kb,peak_committed_bytes,reserved_bytes\n";
+	}
+
+	int exitCode = 0;
+
+	for (const std::string& shape : options.Shapes)
+	{
+		for (size_t objectCount : options.ObjectCounts)
+		{
+			for (const std::string& mode : options.Modes)
+			{
+				BenchmarkResult result;
+
+				if (!runBenchmark(options, shape, objectCount, mode, result))
+				{
+					std::cerr << "unknown shape or mode: " << shape << ", " << mode << '\n';
+					exitCode = 1;
+					continue;
+				}
+
+				printResult(options, result);
+			}
+		}
+	}
+
+	GCManager::Destroy();
+	return exitCode;
+}
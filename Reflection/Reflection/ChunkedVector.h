@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// 고정 크기 청크로 이루어진 가변 길이 배열
+// 커져도 기존 원소가 이동하지 않으므로 한 스레드가 Add 하는 동안 다른 스레드가 [0, GetSize()) 를 읽을 수 있다
+// 제거와 압축은 읽는 스레드가 없을 때만 호출
+template <typename T, size_t ChunkSize = 4096, size_t MaxChunkCount = 16384>
+class ChunkedVector
+{
+	static_assert(std::is_trivially_copyable_v<T>, "ChunkedVector requires trivially copyable T");
+	static_assert((ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two");
+
+public:
+	enum { CHUNK_SIZE = ChunkSize };
+
+	ChunkedVector() = default;
+
+	~ChunkedVector()
+	{
+		for (std::atomic<T*>& chunk : mChunks)
+		{
+			delete[] chunk.load(std::memory_order_relaxed);
+		}
+	}
+
+	ChunkedVector(const ChunkedVector&) = delete;
+	ChunkedVector& operator=(const ChunkedVector&) = delete;
+
+	// 추가하는 스레드는 하나여야 한다
+	void Add(const T& value)
+	{
+		const size_t size = mSize.load(std::memory_order_relaxed);
+		const size_t chunkIndex = size / ChunkSize;
+		assert(chunkIndex < MaxChunkCount && "ChunkedVector::Add - chunk directory is full");
+
+		T* chunk = mChunks[chunkIndex].load(std::memory_order_relaxed);
+
+		if (chunk == nullptr)
+		{
+			chunk = new T[ChunkSize];
+			mChunks[chunkIndex].store(chunk, std::memory_order_release);
+		}
+
+		chunk[size & CHUNK_MASK] = value;
+		mSize.store(size + 1, std::memory_order_release);
+	}
+
+	T& operator[](size_t index)
+	{
+		assert(index < GetSize());
+		return chunkAt(index)[index & CHUNK_MASK];
+	}
+
+	const T& operator[](size_t index) const
+	{
+		assert(index < GetSize());
+		return chunkAt(index)[index & CHUNK_MASK];
+	}
+
+	// 마지막 원소를 index 로 옮겨 O(1) 에 제거, 순서는 유지하지 않는다
+	void RemoveAtSwapLast(size_t index)
+	{
+		const size_t size = GetSize();
+		assert(index < size);
+
+		(*this)[index] = (*this)[size - 1];
+		mSize.store(size - 1, std::memory_order_release);
+	}
+
+	void RemoveLast()
+	{
+		assert(!IsEmpty());
+		mSize.store(GetSize() - 1, std::memory_order_release);
+	}
+
+	// 청크는 해제하지 않고 다시 커질 때 재사용
+	void ShrinkTo(size_t size)
+	{
+		assert(size <= GetSize());
+		mSize.store(size, std::memory_order_release);
+	}
+
+	size_t GetSize() const { return mSize.load(std::memory_order_acquire); }
+	bool IsEmpty() const { return GetSize() == 0; }
+
+	//-------------------- 청크 단위 병렬 처리 --------------------
+	size_t GetChunkCount() const { return (GetSize() + ChunkSize - 1) / ChunkSize; }
+
+	T* GetChunk(size_t chunkIndex) { return mChunks[chunkIndex].load(std::memory_order_acquire); }
+
+	size_t GetChunkLength(size_t chunkIndex) const
+	{
+		return std::min<size_t>(ChunkSize, GetSize() - chunkIndex * ChunkSize);
+	}
+
+	// 각 청크의 남길 원소가 청크 앞쪽 liveCounts[i] 개에 모여 있을 때 전체를 앞으로 당겨 연속되게 만든다
+	void CompactChunks(const std::vector<size_t>& liveCounts)
+	{
+		assert(liveCounts.size() == GetChunkCount());
+
+		size_t destIndex = 0;
+
+		for (size_t chunkIndex = 0; chunkIndex < liveCounts.size(); ++chunkIndex)
+		{
+			const T* source = GetChunk(chunkIndex);
+			size_t remaining = liveCounts[chunkIndex];
+
+			if (destIndex == chunkIndex * ChunkSize)
+			{
+				destIndex += remaining;
+				continue;
+			}
+
+			while (remaining > 0)
+			{
+				const size_t destOffset = destIndex & CHUNK_MASK;
+				const size_t length = std::min(remaining, ChunkSize - destOffset);
+
+				std::memmove(chunkAt(destIndex) + destOffset, source, length * sizeof(T));
+
+				source += length;
+				destIndex += length;
+				remaining -= length;
+			}
+		}
+
+		mSize.store(destIndex, std::memory_order_release);
+	}
+
+private:
+	T* chunkAt(size_t index) const
+	{
+		return mChunks[index / ChunkSize].load(std::memory_order_relaxed);
+	}
+
+private:
+	enum : size_t { CHUNK_MASK = ChunkSize - 1 };
+
+	std::array<std::atomic<T*>, MaxChunkCount> mChunks = {};
+	alignas(64) std::atomic<size_t> mSize = 0;
+};
@@ -13,16 +13,16 @@ class FixedVector
 
 public:
 	using ValueType = T;
-	using value_type = T;  // STL ȣȯ  Ÿ Ī
+	using value_type = T;  // STL 호환을 위한 타입 별칭
 	using SizeType = size_t;
-	using size_type = size_t;  // STL ȣȯ  Ÿ Ī
+	using size_type = size_t;  // STL 호환을 위한 타입 별칭
 	using reference = T&;
 	using const_reference = const T&;
 	using pointer = T*;
 	using const_pointer = const T*;
 	using difference_type = std::ptrdiff_t;
 
-	// ݺ Ŭ 
+	// 반복자 클래스 정의
 	class iterator
 	{
 	public:
@@ -34,21 +34,21 @@ public:
 
 		iterator(pointer ptr) : m_ptr(ptr) {}
 
-		//  
+		// 역참조 연산자
 		reference operator*() const { return *m_ptr; }
 		pointer operator->() const { return m_ptr; }
 
-		// / 
+		// 증가/감소 연산자
 		iterator& operator++() { ++m_ptr; return *this; }
 		iterator operator++(int) { iterator tmp = *this; ++m_ptr; return tmp; }
 		iterator& operator--() { --m_ptr; return *this; }
 		iterator operator--(int) { iterator tmp = *this; --m_ptr; return tmp; }
 
-		//  
+		// 비교 연산자
 		bool operator==(const iterator& other) const { return m_ptr == other.m_ptr; }
 		bool operator!=(const iterator& other) const { return m_ptr != other.m_ptr; }
 
-		//  ׼ 
+		// 랜덤 액세스 연산자
 		iterator& operator+=(difference_type n) { m_ptr += n; return *this; }
 		iterator operator+(difference_type n) const { return iterator(m_ptr + n); }
 		friend iterator operator+(difference_type n, const iterator& it) { return iterator(it.m_ptr + n); }
@@ -57,20 +57,20 @@ public:
 		iterator operator-(difference_type n) const { return iterator(m_ptr - n); }
 		difference_type operator-(const iterator& other) const { return m_ptr - other.m_ptr; }
 
-		//   ()
+		// 비교 연산자 (순서)
 		bool operator<(const iterator& other) const { return m_ptr < other.m_ptr; }
 		bool operator>(const iterator& other) const { return m_ptr > other.m_ptr; }
 		bool operator<=(const iterator& other) const { return m_ptr <= other.m_ptr; }
 		bool operator>=(const iterator& other) const { return m_ptr >= other.m_ptr; }
 
-		// ÷ 
+		// 첨자 연산자
 		reference operator[](difference_type n) const { return m_ptr[n]; }
 
 	private:
 		pointer m_ptr;
 	};
 
-	//  ݺ Ŭ 
+	// 상수 반복자 클래스 정의
 	class const_iterator
 	{
 	public:
@@ -83,21 +83,21 @@ public:
 		const_iterator(pointer ptr) : m_ptr(ptr) {}
 		const_iterator(const iterator& it) : m_ptr(&(*it)) {}
 
-		//  
+		// 역참조 연산자
 		reference operator*() const { return *m_ptr; }
 		pointer operator->() const { return m_ptr; }
 
-		// / 
+		// 증가/감소 연산자
 		const_iterator& operator++() { ++m_ptr; return *this; }
 		const_iterator operator++(int) { const_iterator tmp = *this; ++m_ptr; return tmp; }
 		const_iterator& operator--() { --m_ptr; return *this; }
 		const_iterator operator--(int) { const_iterator tmp = *this; --m_ptr; return tmp; }
 
-		//  
+		// 비교 연산자
 		bool operator==(const const_iterator& other) const { return m_ptr == other.m_ptr; }
 		bool operator!=(const const_iterator& other) const { return m_ptr != other.m_ptr; }
 
-		//  ׼ 
+		// 랜덤 액세스 연산자
 		const_iterator& operator+=(difference_type n) { m_ptr += n; return *this; }
 		const_iterator operator+(difference_type n) const { return const_iterator(m_ptr + n); }
 		friend const_iterator operator+(difference_type n, const const_iterator& it) { return const_iterator(it.m_ptr + n); }
@@ -106,20 +106,20 @@ public:
 		const_iterator operator-(difference_type n) const { return const_iterator(m_ptr - n); }
 		difference_type operator-(const const_iterator& other) const { return m_ptr - other.m_ptr; }
 
-		//   ()
+		// 비교 연산자 (순서)
 		bool operator<(const const_iterator& other) const { return m_ptr < other.m_ptr; }
 		bool operator>(const const_iterator& other) const { return m_ptr > other.m_ptr; }
 		bool operator<=(const const_iterator& other) const { return m_ptr <= other.m_ptr; }
 		bool operator>=(const const_iterator& other) const { return m_ptr >= other.m_ptr; }
 
-		// ÷ 
+		// 첨자 연산자
 		reference operator[](difference_type n) const { return m_ptr[n]; }
 
 	private:
 		pointer m_ptr;
 	};
 
-	//  ݺ Ÿ 
+	// 역방향 반복자 타입 정의
 	using reverse_iterator = std::reverse_iterator<iterator>;
 	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
@@ -129,7 +129,7 @@ public:
 	{
 	}
 
-	// ݺ ޼ҵ
+	// 반복자 메소드
 	iterator begin() { return iterator(mElements); }
 	iterator end() { return iterator(mElements + mElementCount); }
 	const_iterator begin() const { return const_iterator(mElements); }
@@ -137,7 +137,7 @@ public:
 	const_iterator cbegin() const { return const_iterator(mElements); }
 	const_iterator cend() const { return const_iterator(mElements + mElementCount); }
 
-	//  ݺ ޼ҵ
+	// 역방향 반복자 메소드
 	reverse_iterator rbegin() { return reverse_iterator(end()); }
 	reverse_iterator rend() { return reverse_iterator(begin()); }
 	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
@@ -219,6 +219,11 @@ public:
 	constexpr size_t GetCapacity() const { return Capacity; }
 	bool IsEmpty() const { return mElementCount == 0; }
 
+	// STL 호환을 위한 연속 메모리 접근
+	T* data() { return mElements; }
+	const T* data() const { return mElements; }
+	size_t size() const { return mElementCount; }
+
 private:
 	PROPERTY(mElements)
 		T mElements[Capacity];
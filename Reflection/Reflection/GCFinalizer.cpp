@@ -0,0 +1,80 @@
+#include "GCFinalizer.h"
+#include "GCHeap.h"
+#include "GCObject.h"
+
+GCFinalizer::GCFinalizer(GCHeap& heap)
+	: mHeap(heap)
+{
+	mThread = std::thread(&GCFinalizer::finalizerLoop, this);
+}
+
+GCFinalizer::~GCFinalizer()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mbStop = true;
+	}
+
+	mWakeCondition.notify_one();
+	mThread.join();
+}
+
+void GCFinalizer::Enqueue(std::vector<GCObject*>&& batch)
+{
+	if (batch.empty())
+	{
+		return;
+	}
+
+	mPendingCount.fetch_add(batch.size(), std::memory_order_relaxed);
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mBatches.push_back(std::move(batch));
+	}
+
+	mWakeCondition.notify_one();
+}
+
+void GCFinalizer::Wait()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mDoneCondition.wait(lock, [this]() { return mBatches.empty() && !mbBusy; });
+}
+
+void GCFinalizer::finalizerLoop()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+
+	while (true)
+	{
+		mWakeCondition.wait(lock, [this]() { return mbStop || !mBatches.empty(); });
+
+		// 종료 요청이 와도 남은 묶음은 모두 처리한다
+		if (mBatches.empty())
+		{
+			return;
+		}
+
+		std::vector<GCObject*> batch = std::move(mBatches.front());
+		mBatches.pop_front();
+		mbBusy = true;
+		lock.unlock();
+
+		for (GCObject* object : batch)
+		{
+			object->~GCObject();
+		}
+
+		for (GCObject* object : batch)
+		{
+			mHeap.Free(object);
+		}
+
+		mPendingCount.fetch_sub(batch.size(), std::memory_order_relaxed);
+
+		lock.lock();
+		mbBusy = false;
+		mDoneCondition.notify_all();
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class GCObject;
+class GCHeap;
+
+// 소멸자가 무거운 객체를 GC 정지 구간 밖에서 묶음 단위로 소멸시키는 전용 스레드
+// 소멸자는 GCManager 에 접근하지 않아야 한다
+class GCFinalizer final
+{
+public:
+	explicit GCFinalizer(GCHeap& heap);
+	~GCFinalizer();
+	GCFinalizer(const GCFinalizer&) = delete;
+	GCFinalizer& operator=(const GCFinalizer&) = delete;
+
+	// 묶음의 소멸자를 모두 호출한 뒤 메모리를 한꺼번에 힙에 반환
+	void Enqueue(std::vector<GCObject*>&& batch);
+	// 큐에 들어간 객체가 모두 소멸될 때까지 대기
+	void Wait();
+
+	inline size_t GetPendingCount() const;
+
+private:
+	void finalizerLoop();
+
+private:
+	GCHeap& mHeap;
+	std::thread mThread;
+
+	std::mutex mMutex;
+	std::condition_variable mWakeCondition;
+	std::condition_variable mDoneCondition;
+
+	std::deque<std::vector<GCObject*>> mBatches;
+	bool mbBusy = false;
+	bool mbStop = false;
+
+	std::atomic<size_t> mPendingCount = 0;
+};
+
+inline size_t GCFinalizer::GetPendingCount() const
+{
+	return mPendingCount.load(std::memory_order_relaxed);
+}
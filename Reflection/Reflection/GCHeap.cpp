@@ -0,0 +1,736 @@
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <malloc.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "GCHeap.h"
+
+namespace
+{
+	constexpr size_t alignUp(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	constexpr size_t PAGE_HEADER_SIZE = alignUp(sizeof(GCPage), GCHeap::SLOT_ALIGNMENT);
+
+	static_assert(static_cast<size_t>(GCHeap::PAGE_SIZE) / GCHeap::SLOT_ALIGNMENT <= static_cast<size_t>(GCPage::MARK_WORD_COUNT) * 64, "GCPage::MarkBits is too small for the smallest size class");
+
+	constexpr size_t PAGES_PER_CHUNK = static_cast<size_t>(GCHeap::RESERVE_CHUNK_SIZE) / GCHeap::PAGE_SIZE;
+	constexpr uint32_t FULL_CHUNK_MASK = ~uint32_t(0);
+
+	static_assert(PAGES_PER_CHUNK == 32, "ReservedChunk::UsedPageMask holds one bit per page");
+}
+
+const std::array<uint16_t, GCHeap::SIZE_CLASS_COUNT> GCHeap::SIZE_CLASS_SLOT_SIZES =
+{
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256, 320, 384, 448, 512,
+	640, 768, 896, 1024, 1280, 1536, 1792, 2048,
+	2560, 3072, 3584, 4096, 5120, 6144, 7168, 8192
+};
+
+// 16바이트 단위 크기 -> 크기 클래스, 할당마다 탐색하지 않도록 미리 계산
+const std::array<uint8_t, GCHeap::SIZE_CLASS_LOOKUP_SIZE> GCHeap::SIZE_CLASS_LOOKUP = []()
+{
+	std::array<uint8_t, SIZE_CLASS_LOOKUP_SIZE> lookup = {};
+	size_t sizeClass = 0;
+
+	for (size_t i = 0; i < lookup.size(); ++i)
+	{
+		while (SIZE_CLASS_SLOT_SIZES[sizeClass] < i * SLOT_ALIGNMENT)
+		{
+			++sizeClass;
+		}
+
+		lookup[i] = static_cast<uint8_t>(sizeClass);
+	}
+
+	return lookup;
+}();
+
+GCHeap::GCHeap()
+{
+}
+
+GCHeap::~GCHeap()
+{
+	for (SizeClass& sizeClass : mSizeClasses)
+	{
+		GCPage* page = sizeClass.Pages;
+
+		while (page != nullptr)
+		{
+			GCPage* next = page->NextPage;
+			const size_t blockSize = page->BlockSize;
+			page->~GCPage();
+			freeBlock(page, blockSize);
+			page = next;
+		}
+	}
+
+	while (mLargePages != nullptr)
+	{
+		GCPage* next = mLargePages->NextPage;
+		const size_t blockSize = mLargePages->BlockSize;
+		mLargePages->~GCPage();
+		freeBlock(mLargePages, blockSize);
+		mLargePages = next;
+	}
+
+	while (mFreeRegionPages != nullptr)
+	{
+		GCPage* next = mFreeRegionPages->NextPage;
+		const size_t blockSize = mFreeRegionPages->BlockSize;
+		mFreeRegionPages->~GCPage();
+		freeBlock(mFreeRegionPages, blockSize);
+		mFreeRegionPages = next;
+	}
+
+	if (mReservation != nullptr)
+	{
+#ifdef _WIN32
+		VirtualFree(mReservation, 0, MEM_RELEASE);
+#else
+		munmap(mReservation, mReservationBytes);
+#endif
+	}
+}
+
+bool GCHeap::Reserve(size_t bytes, bool bHugePages)
+{
+	assert(mReservation == nullptr && GetPageCount() == 0 && "GCHeap::Reserve must be called once before the first page is created");
+
+	const size_t chunkCount = bytes / RESERVE_CHUNK_SIZE;
+
+	if (chunkCount == 0)
+	{
+		return false;
+	}
+
+	// 청크가 거대 페이지 경계에 맞도록 청크 하나만큼 더 잡고 시작 주소를 올린다
+	const size_t reservationBytes = (chunkCount + 1) * RESERVE_CHUNK_SIZE;
+
+#ifdef _WIN32
+	void* reservation = VirtualAlloc(nullptr, reservationBytes, MEM_RESERVE, PAGE_NOACCESS);
+
+	if (reservation == nullptr)
+	{
+		return false;
+	}
+
+	(void)bHugePages;
+#else
+	void* reservation = mmap(nullptr, reservationBytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+	if (reservation == MAP_FAILED)
+	{
+		return false;
+	}
+#endif
+
+	mReservation = reservation;
+	mReservationBytes = reservationBytes;
+	mReserveBase = reinterpret_cast<char*>(alignUp(reinterpret_cast<uintptr_t>(reservation), RESERVE_CHUNK_SIZE));
+	mReservedBytes = chunkCount * RESERVE_CHUNK_SIZE;
+	mReservedChunks.assign(chunkCount, ReservedChunk{});
+
+#if defined(MADV_HUGEPAGE)
+	// 플래그는 커밋할 때 mprotect 로 나뉘는 매핑에도 이어진다
+	if (bHugePages)
+	{
+		madvise(mReserveBase, mReservedBytes, MADV_HUGEPAGE);
+	}
+#elif !defined(_WIN32)
+	(void)bHugePages;
+#endif
+
+	return true;
+}
+
+void GCHeap::ReleaseBuffer(GCAllocationBuffer& buffer)
+{
+	releaseSlots(buffer.Slots);
+}
+
+void GCHeap::releaseSlots(LocalSlotArray& localSlots)
+{
+	for (size_t classIndex = 0; classIndex < SIZE_CLASS_COUNT; ++classIndex)
+	{
+		LocalSlots& local = localSlots[classIndex];
+
+		for (; local.BumpCursor != local.BumpEnd; local.BumpCursor += SIZE_CLASS_SLOT_SIZES[classIndex])
+		{
+			Free(local.BumpCursor);
+		}
+
+		local.BumpCursor = nullptr;
+		local.BumpEnd = nullptr;
+
+		while (local.FreeList != nullptr)
+		{
+			void* slot = local.FreeList;
+			local.FreeList = *static_cast<void**>(slot);
+			Free(slot);
+		}
+	}
+}
+
+void GCHeap::Free(void* ptr)
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	GCPage* page = GetPage(ptr);
+
+	if (page->SizeClass == LARGE_SIZE_CLASS)
+	{
+		{
+			std::lock_guard<GCSpinLock> largeLock(mLargePageLock);
+
+			if (page->PrevPage != nullptr)
+			{
+				page->PrevPage->NextPage = page->NextPage;
+			}
+			else
+			{
+				mLargePages = page->NextPage;
+			}
+
+			if (page->NextPage != nullptr)
+			{
+				page->NextPage->PrevPage = page->PrevPage;
+			}
+		}
+
+		const size_t blockSize = page->BlockSize;
+		page->~GCPage();
+		freeBlock(page, blockSize);
+		mPageCount.fetch_sub(1, std::memory_order_relaxed);
+
+		return;
+	}
+
+	bool bRelink = false;
+
+	{
+		std::lock_guard<GCSpinLock> pageLock(page->Lock);
+
+		*static_cast<void**>(ptr) = page->FreeList;
+		page->FreeList = ptr;
+		--page->UsedCount;
+
+		// 다른 Free 가 이미 다시 연결하러 갔으면 맡긴다
+		bRelink = !page->bInPartialList && !page->bRelinkPending;
+		page->bRelinkPending |= bRelink;
+	}
+
+	// 가득 찼던 페이지에 빈 슬롯이 생기면 다시 할당 대상이 된다
+	// 할당과 같은 순서(클래스 -> 페이지)로 다시 잠그는 사이에 나머지 슬롯이 해제되어도
+	// bRelinkPending 이 켜져 있으므로 ReleaseEmptyPages 가 페이지를 반환하지 않는다
+	if (bRelink)
+	{
+		SizeClass& sizeClass = mSizeClasses[page->SizeClass];
+		std::lock_guard<GCSpinLock> classLock(sizeClass.Lock);
+		std::lock_guard<GCSpinLock> pageLock(page->Lock);
+
+		if (!page->bInPartialList && page->UsedCount < page->SlotCount)
+		{
+			page->bInPartialList = true;
+			page->NextPartial = sizeClass.PartialPages;
+			sizeClass.PartialPages = page;
+		}
+
+		page->bRelinkPending = false;
+	}
+}
+
+void GCHeap::ReleaseEmptyPages()
+{
+	for (SizeClass& sizeClass : mSizeClasses)
+	{
+		std::lock_guard<GCSpinLock> classLock(sizeClass.Lock);
+
+		bool bKeptEmptyPage = false;
+		GCPage** link = &sizeClass.Pages;
+
+		sizeClass.PartialPages = nullptr;
+
+		while (*link != nullptr)
+		{
+			GCPage* page = *link;
+
+			// 파이널라이저 스레드가 동시에 Free 할 수 있으므로 페이지 상태는 잠근 채로 읽는다
+			page->Lock.lock();
+
+			if (page->UsedCount == 0 && bKeptEmptyPage && !page->bRelinkPending)
+			{
+				page->Lock.unlock();
+
+				*link = page->NextPage;
+				const size_t blockSize = page->BlockSize;
+				page->~GCPage();
+				freeBlock(page, blockSize);
+				mPageCount.fetch_sub(1, std::memory_order_relaxed);
+
+				continue;
+			}
+
+			if (page->UsedCount == 0)
+			{
+				bKeptEmptyPage = true;
+			}
+
+			// 빈 슬롯 목록을 다시 구성
+			page->bInPartialList = page->UsedCount < page->SlotCount;
+			page->NextPartial = nullptr;
+
+			if (page->bInPartialList)
+			{
+				page->NextPartial = sizeClass.PartialPages;
+				sizeClass.PartialPages = page;
+			}
+
+			page->Lock.unlock();
+			link = &page->NextPage;
+		}
+	}
+
+	decommitEmptyChunks();
+}
+
+void GCHeap::ClearMarkBits(bool bClearScanBits)
+{
+	for (SizeClass& sizeClass : mSizeClasses)
+	{
+		std::lock_guard<GCSpinLock> classLock(sizeClass.Lock);
+
+		for (GCPage* page = sizeClass.Pages; page != nullptr; page = page->NextPage)
+		{
+			// 사용 중인 슬롯 범위의 워드만 비운다
+			// 다른 스레드가 증분 수집 중에 할당한 객체를 검은색으로 칠하고 있을 수 있어 원자적으로 쓴다
+			const size_t wordCount = (static_cast<size_t>(page->BumpIndex) + 63) / 64;
+
+			for (size_t i = 0; i < wordCount; ++i)
+			{
+				std::atomic_ref<uint64_t>(page->MarkBits[i]).store(0, std::memory_order_relaxed);
+
+				if (bClearScanBits)
+				{
+					std::atomic_ref<uint64_t>(page->ScanBits[i]).store(0, std::memory_order_relaxed);
+				}
+			}
+		}
+	}
+
+	std::lock_guard<GCSpinLock> largeLock(mLargePageLock);
+
+	for (GCPage* page = mLargePages; page != nullptr; page = page->NextPage)
+	{
+		std::atomic_ref<uint64_t>(page->MarkBits[0]).store(0, std::memory_order_relaxed);
+		std::atomic_ref<uint64_t>(page->ScanBits[0]).store(0, std::memory_order_relaxed);
+	}
+}
+
+size_t GCHeap::BeginEvacuation(double maxOccupancy)
+{
+	size_t evacuatedPageCount = 0;
+	std::vector<GCPage*> pages;
+
+	// 남은 슬롯이 비울 페이지에 있으면 옮긴 객체가 다시 그 페이지에 놓이므로 먼저 돌려준다
+	releaseSlots(mOwnerSlots);
+
+	for (SizeClass& sizeClass : mSizeClasses)
+	{
+		std::lock_guard<GCSpinLock> classLock(sizeClass.Lock);
+
+		pages.clear();
+		size_t freeSlotCount = 0;
+
+		for (GCPage* page = sizeClass.Pages; page != nullptr; page = page->NextPage)
+		{
+			pages.push_back(page);
+			freeSlotCount += page->SlotCount - page->UsedCount;
+		}
+
+		// 가장 빈 페이지부터, 비우고 나서도 남은 페이지에 객체가 다 들어갈 때까지만 고른다
+		std::sort(pages.begin(), pages.end(), [](const GCPage* lhs, const GCPage* rhs) {
+			return lhs->UsedCount < rhs->UsedCount;
+			});
+
+		for (GCPage* page : pages)
+		{
+			if (page->UsedCount == 0 || page->bPinned)
+			{
+				continue;
+			}
+
+			if (page->UsedCount >= page->SlotCount * maxOccupancy || freeSlotCount < page->SlotCount)
+			{
+				break;
+			}
+
+			// 이 페이지의 빈 슬롯은 쓸 수 없게 되고, 살아있는 객체만큼 다른 페이지의 슬롯을 차지한다
+			freeSlotCount -= page->SlotCount;
+			page->bEvacuating = true;
+			++evacuatedPageCount;
+		}
+
+		// 빽빽한 페이지부터 채워 빈 페이지가 그대로 남도록 할당 목록을 다시 구성
+		sizeClass.PartialPages = nullptr;
+
+		for (GCPage* page : pages)
+		{
+			std::lock_guard<GCSpinLock> pageLock(page->Lock);
+
+			page->bInPartialList = !page->bEvacuating && page->UsedCount < page->SlotCount;
+			page->NextPartial = nullptr;
+
+			if (page->bInPartialList)
+			{
+				page->NextPartial = sizeClass.PartialPages;
+				sizeClass.PartialPages = page;
+			}
+		}
+	}
+
+	return evacuatedPageCount;
+}
+
+void GCHeap::EndEvacuation()
+{
+	for (SizeClass& sizeClass : mSizeClasses)
+	{
+		std::lock_guard<GCSpinLock> classLock(sizeClass.Lock);
+
+		for (GCPage* page = sizeClass.Pages; page != nullptr; page = page->NextPage)
+		{
+			page->bEvacuating = false;
+			page->bPinned = false;
+		}
+	}
+
+	std::lock_guard<GCSpinLock> largeLock(mLargePageLock);
+
+	for (GCPage* page = mLargePages; page != nullptr; page = page->NextPage)
+	{
+		page->bPinned = false;
+	}
+}
+
+size_t GCHeap::GetSizeClassSlotSize(size_t sizeClass)
+{
+	assert(sizeClass < SIZE_CLASS_COUNT);
+	return SIZE_CLASS_SLOT_SIZES[sizeClass];
+}
+
+GCPage* GCHeap::createPage(size_t sizeClass)
+{
+	void* block = allocateBlock(PAGE_SIZE);
+	GCPage* page = new (block) GCPage();
+
+	page->SizeClass = static_cast<uint32_t>(sizeClass);
+	page->SlotSize = SIZE_CLASS_SLOT_SIZES[sizeClass];
+	page->SlotCount = static_cast<uint32_t>((PAGE_SIZE - PAGE_HEADER_SIZE) / page->SlotSize);
+	page->BlockSize = PAGE_SIZE;
+	page->SlotBegin = static_cast<char*>(block) + PAGE_HEADER_SIZE;
+	page->SlotIndexMultiplier = (uint64_t(1) << 32) / page->SlotSize + 1;
+
+	mPageCount.fetch_add(1, std::memory_order_relaxed);
+
+	return page;
+}
+
+GCPage* GCHeap::getPartialPage(size_t classIndex)
+{
+	SizeClass& sizeClass = mSizeClasses[classIndex];
+	GCPage* page = sizeClass.PartialPages;
+
+	if (page == nullptr)
+	{
+		page = createPage(classIndex);
+		page->NextPage = sizeClass.Pages;
+		sizeClass.Pages = page;
+		page->bInPartialList = true;
+		sizeClass.PartialPages = page;
+	}
+
+	return page;
+}
+
+void* GCHeap::refillSlots(size_t classIndex, LocalSlots& local)
+{
+	SizeClass& sizeClass = mSizeClasses[classIndex];
+	std::lock_guard<GCSpinLock> classLock(sizeClass.Lock);
+
+	GCPage* page = getPartialPage(classIndex);
+
+	std::lock_guard<GCSpinLock> pageLock(page->Lock);
+
+	const uint32_t wantCount = std::max<uint32_t>(1, ALLOCATION_BUFFER_BYTES / page->SlotSize);
+	uint32_t takeCount = 0;
+	void* slot = nullptr;
+
+	// 빈 목록이 있으면 앞부분을 잘라 오고, 없으면 아직 쓰지 않은 슬롯을 범위로 받아 와 할당할 때까지 건드리지 않는다
+	if (page->FreeList != nullptr)
+	{
+		slot = page->FreeList;
+		void* last = slot;
+		takeCount = 1;
+
+		while (takeCount < wantCount && *static_cast<void**>(last) != nullptr)
+		{
+			last = *static_cast<void**>(last);
+			++takeCount;
+		}
+
+		page->FreeList = *static_cast<void**>(last);
+		*static_cast<void**>(last) = nullptr;
+		local.FreeList = *static_cast<void**>(slot);
+	}
+	else
+	{
+		assert(page->BumpIndex < page->SlotCount);
+		takeCount = std::min(wantCount, page->SlotCount - page->BumpIndex);
+		slot = page->SlotBegin + static_cast<size_t>(page->BumpIndex) * page->SlotSize;
+		page->BumpIndex += takeCount;
+		local.BumpCursor = static_cast<char*>(slot) + page->SlotSize;
+		local.BumpEnd = static_cast<char*>(slot) + static_cast<size_t>(takeCount) * page->SlotSize;
+	}
+
+	page->UsedCount += takeCount;
+
+	if (page->UsedCount == page->SlotCount)
+	{
+		sizeClass.PartialPages = page->NextPartial;
+		page->NextPartial = nullptr;
+		page->bInPartialList = false;
+	}
+
+	return slot;
+}
+
+void* GCHeap::allocateLarge(size_t size)
+{
+	// 큰 객체는 전용 블록을 사용하고 해제 즉시 시스템에 반환
+	const size_t blockSize = alignUp(PAGE_HEADER_SIZE + size, PAGE_SIZE);
+	void* block = allocateBlock(blockSize);
+	GCPage* page = new (block) GCPage();
+
+	page->SizeClass = LARGE_SIZE_CLASS;
+	page->SlotSize = 0;
+	page->SlotCount = 1;
+	page->UsedCount = 1;
+	page->BlockSize = blockSize;
+	page->SlotBegin = static_cast<char*>(block) + PAGE_HEADER_SIZE;
+
+	{
+		std::lock_guard<GCSpinLock> largeLock(mLargePageLock);
+
+		page->NextPage = mLargePages;
+
+		if (mLargePages != nullptr)
+		{
+			mLargePages->PrevPage = page;
+		}
+
+		mLargePages = page;
+	}
+
+	mPageCount.fetch_add(1, std::memory_order_relaxed);
+
+	return page->SlotBegin;
+}
+
+GCPage* GCHeap::AcquireRegionPage(size_t size)
+{
+	const size_t blockSize = alignUp(PAGE_HEADER_SIZE + size, PAGE_SIZE);
+
+	if (blockSize == PAGE_SIZE)
+	{
+		std::lock_guard<GCSpinLock> lock(mRegionPageLock);
+
+		if (mFreeRegionPages != nullptr)
+		{
+			GCPage* page = mFreeRegionPages;
+			mFreeRegionPages = page->NextPage;
+			page->NextPage = nullptr;
+
+			return page;
+		}
+	}
+
+	void* block = allocateBlock(blockSize);
+	GCPage* page = new (block) GCPage();
+
+	// 객체 크기는 영역이 관리한다, 슬롯 크기는 마크 비트맵 범위를 벗어나지 않도록 가장 작은 단위로 둔다
+	page->SizeClass = REGION_SIZE_CLASS;
+	page->SlotSize = SLOT_ALIGNMENT;
+	page->SlotCount = static_cast<uint32_t>((PAGE_SIZE - PAGE_HEADER_SIZE) / SLOT_ALIGNMENT);
+	page->BlockSize = blockSize;
+	page->SlotBegin = static_cast<char*>(block) + PAGE_HEADER_SIZE;
+	page->SlotIndexMultiplier = (uint64_t(1) << 32) / SLOT_ALIGNMENT + 1;
+
+	mRegionPageCount.fetch_add(1, std::memory_order_relaxed);
+
+	return page;
+}
+
+void GCHeap::ReleaseRegionPage(GCPage* page)
+{
+	assert(page->SizeClass == REGION_SIZE_CLASS);
+
+	if (page->BlockSize == PAGE_SIZE)
+	{
+		std::lock_guard<GCSpinLock> lock(mRegionPageLock);
+
+		page->NextPage = mFreeRegionPages;
+		mFreeRegionPages = page;
+
+		return;
+	}
+
+	const size_t blockSize = page->BlockSize;
+	page->~GCPage();
+	freeBlock(page, blockSize);
+	mRegionPageCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void* GCHeap::allocateBlock(size_t size)
+{
+	// 큰 객체 블록은 여러 페이지가 이어져야 하므로 예약 범위는 한 페이지짜리만 쓴다
+	if (size == PAGE_SIZE && mReserveBase != nullptr)
+	{
+		if (void* page = allocateReservedPage())
+		{
+			return page;
+		}
+	}
+
+#ifdef _WIN32
+	void* block = _aligned_malloc(size, PAGE_SIZE);
+#else
+	void* block = std::aligned_alloc(PAGE_SIZE, size);
+#endif
+
+	if (block == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	mCommittedBytes.fetch_add(size, std::memory_order_relaxed);
+
+	return block;
+}
+
+void GCHeap::freeBlock(void* block, size_t size)
+{
+	// 예약 범위의 페이지는 비트만 지우고, 청크가 통째로 비면 ReleaseEmptyPages 에서 돌려준다
+	if (isReserved(block))
+	{
+		const size_t pageIndex = (static_cast<char*>(block) - mReserveBase) / PAGE_SIZE;
+		const size_t chunkIndex = pageIndex / PAGES_PER_CHUNK;
+
+		std::lock_guard<GCSpinLock> lock(mReserveLock);
+
+		mReservedChunks[chunkIndex].UsedPageMask &= ~(uint32_t(1) << (pageIndex % PAGES_PER_CHUNK));
+		mReserveHint = std::min(mReserveHint, chunkIndex);
+
+		return;
+	}
+
+#ifdef _WIN32
+	_aligned_free(block);
+#else
+	std::free(block);
+#endif
+
+	mCommittedBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+void* GCHeap::allocateReservedPage()
+{
+	std::lock_guard<GCSpinLock> lock(mReserveLock);
+
+	// 앞쪽 청크부터 채워 뒤쪽 청크가 통째로 비기 쉽게 한다
+	for (size_t chunkIndex = mReserveHint; chunkIndex < mReservedChunks.size(); ++chunkIndex)
+	{
+		ReservedChunk& chunk = mReservedChunks[chunkIndex];
+
+		if (chunk.UsedPageMask == FULL_CHUNK_MASK)
+		{
+			continue;
+		}
+
+		char* chunkBegin = mReserveBase + chunkIndex * RESERVE_CHUNK_SIZE;
+
+		if (!chunk.bCommitted)
+		{
+#ifdef _WIN32
+			const bool bCommitted = VirtualAlloc(chunkBegin, RESERVE_CHUNK_SIZE, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+			const bool bCommitted = mprotect(chunkBegin, RESERVE_CHUNK_SIZE, PROT_READ | PROT_WRITE) == 0;
+#endif
+
+			if (!bCommitted)
+			{
+				return nullptr;
+			}
+
+			chunk.bCommitted = true;
+			mCommittedBytes.fetch_add(RESERVE_CHUNK_SIZE, std::memory_order_relaxed);
+		}
+
+		const int pageIndex = std::countr_one(chunk.UsedPageMask);
+		chunk.UsedPageMask |= uint32_t(1) << pageIndex;
+		mReserveHint = chunkIndex;
+
+		return chunkBegin + static_cast<size_t>(pageIndex) * PAGE_SIZE;
+	}
+
+	mReserveHint = mReservedChunks.size();
+	return nullptr;
+}
+
+void GCHeap::decommitEmptyChunks()
+{
+	if (mReserveBase == nullptr)
+	{
+		return;
+	}
+
+	std::lock_guard<GCSpinLock> lock(mReserveLock);
+
+	for (size_t chunkIndex = 0; chunkIndex < mReservedChunks.size(); ++chunkIndex)
+	{
+		ReservedChunk& chunk = mReservedChunks[chunkIndex];
+
+		if (!chunk.bCommitted || chunk.UsedPageMask != 0)
+		{
+			continue;
+		}
+
+		char* chunkBegin = mReserveBase + chunkIndex * RESERVE_CHUNK_SIZE;
+
+		// 리눅스는 매핑을 그대로 두고 물리 메모리만 돌려준다, 다시 쓰면 0으로 채워진 페이지가 들어온다
+#ifdef _WIN32
+		VirtualFree(chunkBegin, RESERVE_CHUNK_SIZE, MEM_DECOMMIT);
+#else
+		madvise(chunkBegin, RESERVE_CHUNK_SIZE, MADV_DONTNEED);
+#endif
+
+		chunk.bCommitted = false;
+		mCommittedBytes.fetch_sub(RESERVE_CHUNK_SIZE, std::memory_order_relaxed);
+	}
+}
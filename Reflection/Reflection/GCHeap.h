@@ -0,0 +1,398 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#define GC_CPU_PAUSE() _mm_pause()
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+#include <intrin.h>
+#define GC_CPU_PAUSE() __yield()
+#elif defined(__x86_64__) || defined(__i386__)
+#define GC_CPU_PAUSE() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define GC_CPU_PAUSE() asm volatile("yield")
+#else
+#define GC_CPU_PAUSE() ((void)0)
+#endif
+
+class GCSpinLock final
+{
+public:
+	void lock()
+	{
+		while (mFlag.test_and_set(std::memory_order_acquire))
+		{
+			// 잠금을 쥔 스레드가 선점되었을 수 있으므로 한동안 쉬며 돌다가 실행을 양보한다
+			for (uint32_t spinCount = 0; mFlag.test(std::memory_order_relaxed); ++spinCount)
+			{
+				if (spinCount < SPIN_LIMIT)
+				{
+					GC_CPU_PAUSE();
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+	}
+
+	void unlock()
+	{
+		mFlag.clear(std::memory_order_release);
+	}
+
+private:
+	enum { SPIN_LIMIT = 64 };
+
+	std::atomic_flag mFlag;
+};
+
+// 페이지 시작 위치에 놓이는 헤더, 객체 주소를 PAGE_SIZE 로 내림하면 찾을 수 있다
+struct GCPage
+{
+	enum { MARK_WORD_COUNT = 64 };
+
+	uint32_t SizeClass = 0;
+	uint32_t SlotSize = 0;
+	uint32_t SlotCount = 0;
+	uint32_t UsedCount = 0;
+	uint32_t BumpIndex = 0;  // 아직 한 번도 할당되지 않은 첫 슬롯
+	bool bInPartialList = false;
+	bool bRelinkPending = false; // Free 가 크기 클래스 잠금을 기다리며 다시 연결하려는 중, ReleaseEmptyPages 가 반환하지 않는다
+	bool bEvacuating = false; // 압축 중 객체를 다른 페이지로 옮기는 중
+	bool bPinned = false;     // 압축 중 옮길 수 없는 객체가 있다
+	size_t BlockSize = 0;
+
+	char* SlotBegin = nullptr;
+	void* FreeList = nullptr;
+	uint64_t SlotIndexMultiplier = 0; // 나눗셈 대신 곱셈과 시프트로 슬롯 번호 계산
+
+	GCPage* PrevPage = nullptr;     // 큰 객체 블록 목록에서만 사용
+	GCPage* NextPage = nullptr;     // 크기 클래스의 전체 페이지 목록
+	GCPage* NextPartial = nullptr;  // 빈 슬롯이 있는 페이지 목록
+
+	GCSpinLock Lock;
+
+	// 슬롯마다 1비트, 객체 캐시 라인을 건드리지 않고 마킹
+	alignas(std::atomic_ref<uint64_t>::required_alignment) uint64_t MarkBits[MARK_WORD_COUNT] = {};
+	// 동시 마킹에서 참조를 다 읽은(검은) 객체, 마크 비트와 같은 배치
+	alignas(std::atomic_ref<uint64_t>::required_alignment) uint64_t ScanBits[MARK_WORD_COUNT] = {};
+
+	inline size_t GetSlotIndex(const void* ptr) const;
+};
+
+struct GCAllocationBuffer;
+
+// 크기별로 분리된 페이지에서 GCObject 메모리를 할당하는 힙
+class GCHeap final
+{
+public:
+	enum { PAGE_SIZE = 64 * 1024 };
+	enum
+	{
+		SLOT_ALIGNMENT = 16,
+		MAX_SMALL_SIZE = 8192,
+		SIZE_CLASS_LOOKUP_SIZE = MAX_SMALL_SIZE / SLOT_ALIGNMENT + 1,
+	};
+	enum { SIZE_CLASS_COUNT = 32 };
+	enum { LARGE_SIZE_CLASS = SIZE_CLASS_COUNT };
+	enum { REGION_SIZE_CLASS = SIZE_CLASS_COUNT + 1 }; // GCRegion 의 덩어리, 수집 대상이 아니다
+	enum { ALLOCATION_BUFFER_BYTES = 16 * 1024 }; // 스레드 버퍼를 한 번 채울 때 가져오는 슬롯 크기의 합
+	enum { RESERVE_CHUNK_SIZE = 2 * 1024 * 1024 }; // 예약 범위를 커밋하고 OS 에 돌려주는 단위, 투명 거대 페이지 하나
+
+	// 한 스레드가 잠금 없이 꺼내 쓰는 크기 클래스 하나의 슬롯, 힙 입장에서는 이미 할당된 슬롯
+	struct LocalSlots
+	{
+		void* FreeList = nullptr; // 슬롯 첫 워드로 이어진 목록
+		char* BumpCursor = nullptr; // 페이지에서 한 번도 쓰지 않은 슬롯을 통째로 받아 온 범위, 건드리지 않고 밀어 낸다
+		char* BumpEnd = nullptr;
+	};
+	using LocalSlotArray = std::array<LocalSlots, SIZE_CLASS_COUNT>;
+
+	GCHeap();
+	~GCHeap();
+	GCHeap(const GCHeap&) = delete;
+	GCHeap& operator=(const GCHeap&) = delete;
+
+	// 페이지를 잘라 쓸 가상 주소 범위를 미리 예약, 첫 페이지를 만들기 전에 한 번만 호출
+	// 청크는 처음 쓸 때 커밋하고, 예약에 실패하거나 범위를 다 쓰면 페이지마다 시스템에서 할당한다
+	// bHugePages 이면 범위 전체에 madvise(MADV_HUGEPAGE), 리눅스에서만 동작
+	bool Reserve(size_t bytes, bool bHugePages);
+	inline size_t GetReservedBytes() const;
+	// 예약 범위에서 커밋한 청크와 범위 밖에서 할당한 블록(큰 객체 포함)의 합
+	inline size_t GetCommittedBytes() const;
+
+	// 힙을 가진 스레드(변경자) 전용, 힙이 가진 버퍼에서 AllocateLocal 과 같이 잠금 없이 꺼낸다
+	inline void* Allocate(size_t size);
+	// 스레드 하나가 독점하는 buffer 에서 잠금 없이 꺼내고, 비었을 때만 크기 클래스를 잠그고 여러 슬롯을 한 번에 채운다
+	// 큰 객체는 Allocate 와 같다
+	inline void* AllocateLocal(size_t size, GCAllocationBuffer& buffer);
+	// 버퍼에 남은 슬롯을 빈 목록으로 돌려준다, 스레드가 끝날 때 호출
+	void ReleaseBuffer(GCAllocationBuffer& buffer);
+	// 여러 스윕 스레드에서 동시에 호출 가능
+	void Free(void* ptr);
+
+	// 스윕이 끝난 뒤 크기 클래스마다 하나만 남기고 빈 페이지를 시스템에 반환
+	// 예약 범위에서는 사용 중인 페이지가 없는 청크를 MADV_DONTNEED(윈도우는 MEM_DECOMMIT)로 돌려준다
+	void ReleaseEmptyPages();
+
+	// 마킹 시작 전에 모든 페이지의 마크 비트맵을 비운다, bClearScanBits 이면 동시 마킹용 검사 비트맵도
+	void ClearMarkBits(bool bClearScanBits = false);
+
+	// 압축 수집용, 고정된 페이지와 큰 객체 블록을 제외하고 사용률이 maxOccupancy 미만인 페이지를
+	// 남은 페이지의 빈 슬롯에 다 옮길 수 있는 만큼 비울 페이지로 고른다, 이후 할당은 빽빽한 페이지부터 채운다
+	size_t BeginEvacuation(double maxOccupancy);
+	// 비울 페이지, 고정 표시를 지운다, 옛 슬롯을 Free 한 뒤 ReleaseEmptyPages 로 반환
+	void EndEvacuation();
+
+	// GCRegion 이 객체를 밀어 넣는 덩어리, 헤더 뒤부터 size 바이트 이상을 쓸 수 있다
+	// 한 페이지에 들어가면 끝난 영역이 돌려준 페이지를 다시 쓰고, 아니면 전용 블록을 만든다
+	GCPage* AcquireRegionPage(size_t size);
+	// 한 페이지짜리는 다음 영역을 위해 남기고 전용 블록은 바로 반환
+	void ReleaseRegionPage(GCPage* page);
+	inline static bool IsRegion(const void* ptr);
+	// 영역에서 쓰고 있거나 다시 쓰려고 남겨 둔 페이지 수, GetPageCount 에 포함되지 않는다
+	inline size_t GetRegionPageCount() const;
+
+	inline static void PinPage(const void* ptr);
+	inline static bool IsEvacuating(const void* ptr);
+
+	inline static bool IsMarked(const void* ptr);
+	// 이번 호출로 처음 마킹되었으면 true, 여러 스레드에서 동시에 호출 가능
+	inline static bool Mark(const void* ptr);
+	inline static void ClearMark(const void* ptr);
+
+	// SetScanned 이전에 객체에서 읽은 값이 IsScanned 로 true 를 본 스레드의 이후 쓰기보다 앞선다
+	inline static bool IsScanned(const void* ptr);
+	inline static void SetScanned(const void* ptr);
+
+	inline static GCPage* GetPage(const void* ptr);
+	// 객체가 차지하는 슬롯 크기, 큰 객체는 헤더를 포함한 블록 크기
+	inline static size_t GetAllocationSize(const void* ptr);
+	inline size_t GetPageCount() const;
+
+	// MAX_SMALL_SIZE 보다 크면 LARGE_SIZE_CLASS
+	inline static size_t GetSizeClass(size_t size);
+
+	static size_t GetSizeClassSlotSize(size_t sizeClass);
+
+private:
+	struct SizeClass
+	{
+		GCSpinLock Lock;
+		GCPage* Pages = nullptr;
+		GCPage* PartialPages = nullptr;
+	};
+
+	GCPage* createPage(size_t sizeClass);
+	// 크기 클래스의 할당 대상 페이지, 없으면 새로 만든다, 크기 클래스를 잠근 채로 호출
+	GCPage* getPartialPage(size_t classIndex);
+	inline void* allocateFromSlots(size_t size, LocalSlotArray& localSlots);
+	// 한 페이지의 빈 목록 일부나 쓰지 않은 범위를 잘라 local 을 채우고 그중 첫 슬롯을 돌려준다
+	void* refillSlots(size_t classIndex, LocalSlots& local);
+	void releaseSlots(LocalSlotArray& localSlots);
+	void* allocateLarge(size_t size);
+
+	void* allocateBlock(size_t size);
+	void freeBlock(void* block, size_t size);
+
+	// 예약 범위의 빈 페이지 하나, 청크가 커밋되지 않았으면 커밋한다, 범위를 다 썼으면 nullptr
+	void* allocateReservedPage();
+	void decommitEmptyChunks();
+	inline bool isReserved(const void* ptr) const;
+
+private:
+	static const std::array<uint16_t, SIZE_CLASS_COUNT> SIZE_CLASS_SLOT_SIZES;
+	static const std::array<uint8_t, SIZE_CLASS_LOOKUP_SIZE> SIZE_CLASS_LOOKUP;
+
+	std::array<SizeClass, SIZE_CLASS_COUNT> mSizeClasses;
+	LocalSlotArray mOwnerSlots = {}; // Allocate 용, 압축 수집에서 비울 페이지를 고르기 전에 돌려준다
+	GCSpinLock mLargePageLock;
+	GCPage* mLargePages = nullptr;
+	std::atomic<size_t> mPageCount = 0;
+
+	GCSpinLock mRegionPageLock;
+	GCPage* mFreeRegionPages = nullptr;
+	std::atomic<size_t> mRegionPageCount = 0;
+
+	struct ReservedChunk
+	{
+		uint32_t UsedPageMask = 0; // 청크 안 페이지마다 1비트
+		bool bCommitted = false;
+	};
+
+	GCSpinLock mReserveLock;
+	void* mReservation = nullptr; // 해제할 때 쓰는 OS 매핑 시작, mReserveBase 는 청크 크기로 올린 주소
+	size_t mReservationBytes = 0;
+	char* mReserveBase = nullptr;
+	size_t mReservedBytes = 0;
+	std::vector<ReservedChunk> mReservedChunks;
+	size_t mReserveHint = 0; // 이 앞의 청크는 가득 찼다
+	std::atomic<size_t> mCommittedBytes = 0;
+};
+
+// 스레드 지역 할당 버퍼, 버퍼에 슬롯이 남은 페이지는 반환되지 않는다
+struct GCAllocationBuffer
+{
+	GCHeap::LocalSlotArray Slots = {};
+};
+
+inline void* GCHeap::Allocate(size_t size)
+{
+	return allocateFromSlots(size, mOwnerSlots);
+}
+
+inline void* GCHeap::AllocateLocal(size_t size, GCAllocationBuffer& buffer)
+{
+	return allocateFromSlots(size, buffer.Slots);
+}
+
+inline void* GCHeap::allocateFromSlots(size_t size, LocalSlotArray& localSlots)
+{
+	if (size > MAX_SMALL_SIZE)
+	{
+		return allocateLarge(size);
+	}
+
+	const size_t classIndex = GetSizeClass(size);
+	LocalSlots& local = localSlots[classIndex];
+
+	if (void* slot = local.FreeList)
+	{
+		local.FreeList = *static_cast<void**>(slot);
+		return slot;
+	}
+
+	if (local.BumpCursor != local.BumpEnd)
+	{
+		void* slot = local.BumpCursor;
+		local.BumpCursor += SIZE_CLASS_SLOT_SIZES[classIndex];
+		return slot;
+	}
+
+	return refillSlots(classIndex, local);
+}
+
+inline size_t GCPage::GetSlotIndex(const void* ptr) const
+{
+	const uint64_t offset = static_cast<uint64_t>(static_cast<const char*>(ptr) - SlotBegin);
+	return static_cast<size_t>((offset * SlotIndexMultiplier) >> 32);
+}
+
+inline bool GCHeap::IsMarked(const void* ptr)
+{
+	GCPage* page = GetPage(ptr);
+	const size_t index = page->GetSlotIndex(ptr);
+
+	return (std::atomic_ref<uint64_t>(page->MarkBits[index >> 6]).load(std::memory_order_relaxed) & (uint64_t(1) << (index & 63))) != 0;
+}
+
+inline bool GCHeap::Mark(const void* ptr)
+{
+	GCPage* page = GetPage(ptr);
+	const size_t index = page->GetSlotIndex(ptr);
+	const uint64_t bit = uint64_t(1) << (index & 63);
+	std::atomic_ref<uint64_t> word(page->MarkBits[index >> 6]);
+
+	// 이미 마킹된 경우 RMW 없이 반환해 캐시 라인 경합을 줄인다
+	if ((word.load(std::memory_order_relaxed) & bit) != 0)
+	{
+		return false;
+	}
+
+	return (word.fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+}
+
+inline void GCHeap::ClearMark(const void* ptr)
+{
+	GCPage* page = GetPage(ptr);
+	const size_t index = page->GetSlotIndex(ptr);
+
+	std::atomic_ref<uint64_t>(page->MarkBits[index >> 6]).fetch_and(~(uint64_t(1) << (index & 63)), std::memory_order_relaxed);
+}
+
+inline bool GCHeap::IsScanned(const void* ptr)
+{
+	GCPage* page = GetPage(ptr);
+	const size_t index = page->GetSlotIndex(ptr);
+
+	return (std::atomic_ref<uint64_t>(page->ScanBits[index >> 6]).load(std::memory_order_acquire) & (uint64_t(1) << (index & 63))) != 0;
+}
+
+inline void GCHeap::SetScanned(const void* ptr)
+{
+	GCPage* page = GetPage(ptr);
+	const size_t index = page->GetSlotIndex(ptr);
+
+	std::atomic_ref<uint64_t>(page->ScanBits[index >> 6]).fetch_or(uint64_t(1) << (index & 63), std::memory_order_release);
+}
+
+inline bool GCHeap::IsRegion(const void* ptr)
+{
+	return GetPage(ptr)->SizeClass == REGION_SIZE_CLASS;
+}
+
+inline size_t GCHeap::GetReservedBytes() const
+{
+	return mReservedBytes;
+}
+
+inline size_t GCHeap::GetCommittedBytes() const
+{
+	return mCommittedBytes.load(std::memory_order_relaxed);
+}
+
+inline bool GCHeap::isReserved(const void* ptr) const
+{
+	return reinterpret_cast<uintptr_t>(ptr) - reinterpret_cast<uintptr_t>(mReserveBase) < mReservedBytes;
+}
+
+inline size_t GCHeap::GetRegionPageCount() const
+{
+	return mRegionPageCount.load(std::memory_order_relaxed);
+}
+
+inline void GCHeap::PinPage(const void* ptr)
+{
+	GetPage(ptr)->bPinned = true;
+}
+
+inline bool GCHeap::IsEvacuating(const void* ptr)
+{
+	return GetPage(ptr)->bEvacuating;
+}
+
+inline GCPage* GCHeap::GetPage(const void* ptr)
+{
+	return reinterpret_cast<GCPage*>(reinterpret_cast<uintptr_t>(ptr) & ~static_cast<uintptr_t>(PAGE_SIZE - 1));
+}
+
+inline size_t GCHeap::GetAllocationSize(const void* ptr)
+{
+	const GCPage* page = GetPage(ptr);
+	return page->SizeClass == LARGE_SIZE_CLASS ? page->BlockSize : page->SlotSize;
+}
+
+inline size_t GCHeap::GetPageCount() const
+{
+	return mPageCount.load(std::memory_order_relaxed);
+}
+
+inline size_t GCHeap::GetSizeClass(size_t size)
+{
+	if (size > MAX_SMALL_SIZE)
+	{
+		return LARGE_SIZE_CLASS;
+	}
+
+	return SIZE_CLASS_LOOKUP[(size + SLOT_ALIGNMENT - 1) / SLOT_ALIGNMENT];
+}
@@ -1,372 +1,2341 @@
-#include <set>
 #include <algorithm>
 #include <vector>
 #include <chrono>
-#include <windows.h>    
 #include <string>       
 #include <sstream>      
 #include <thread>
-#include <future>
 #include <atomic>
-#include <stack>
 
 #include "GCManager.h"
 #include "GCObject.h"
+#include "GCRegion.h"
+
+// 스레드가 끝날 때 캐시를 돌려주기 위한 thread_local 핸들
+struct GCManager::ThreadCacheHandle
+{
+	~ThreadCacheHandle()
+	{
+		if (Cache != nullptr && mInstance != nullptr && mInstance->mInstanceIndex == InstanceIndex)
+		{
+			mInstance->releaseThreadCache(Cache);
+		}
+	}
+
+	uint64_t InstanceIndex = 0;
+	GCThreadCache* Cache = nullptr; // 변경자 스레드는 nullptr
+};
 
 GCManager* GCManager::mInstance = nullptr;
+uint64_t GCManager::mInstanceCount = 0;
+thread_local GCManager::ThreadCacheHandle GCManager::mThreadCache;
+std::atomic<bool> GCManager::mbSafepointRequested = false;
+
+class GCManager::SafepointScope final
+{
+public:
+	explicit SafepointScope(GCManager& gcManager)
+		: mGCManager(gcManager)
+	{
+		if (mGCManager.mSafepointDepth++ == 0)
+		{
+			mGCManager.stopMutatorThreads();
+		}
+	}
+
+	~SafepointScope()
+	{
+		if (--mGCManager.mSafepointDepth == 0)
+		{
+			mGCManager.resumeMutatorThreads();
+		}
+	}
+
+	SafepointScope(const SafepointScope&) = delete;
+	SafepointScope& operator=(const SafepointScope&) = delete;
+
+private:
+	GCManager& mGCManager;
+};
+
+template <typename Func>
+void GCManager::forEachReference(GCObject* object, Func&& func)
+{
+	forEachReferenceRange(object, func, [&func](GCObject** data, size_t count) {
+		for (size_t i = 0; i < count; ++i)
+		{
+			func(data + i);
+		}
+		});
+}
+
+template <typename SlotFunc, typename RangeFunc>
+void GCManager::forEachReferenceRange(GCObject* object, SlotFunc&& slotFunc, RangeFunc&& rangeFunc)
+{
+	const ReferenceMap& referenceMap = object->GetTypeInfo().GetReferenceMap();
+	char* base = reinterpret_cast<char*>(object);
+
+	for (size_t offset : referenceMap.Offsets)
+	{
+		slotFunc(reinterpret_cast<GCObject**>(base + offset));
+	}
+
+	for (const ContainerReference& container : referenceMap.Containers)
+	{
+		void* ptr = base + container.Offset;
+
+		if (GCObject** data = static_cast<GCObject**>(container.IteratorHandler->GetData(ptr)))
+		{
+			rangeFunc(data, container.IteratorHandler->GetCount(ptr));
+		}
+		else
+		{
+			auto iter = container.IteratorHandler->Begin(ptr);
+			auto end = container.IteratorHandler->End(ptr);
+
+			while (*iter != *end)
+			{
+				slotFunc(static_cast<GCObject**>(iter->Dereference()));
+				iter->Increment();
+			}
+		}
+	}
+
+	for (void* slot : referenceMap.StaticSlots)
+	{
+		slotFunc(static_cast<GCObject**>(slot));
+	}
+}
+
+template <typename Func>
+void GCManager::forEachWeakReference(GCObject* object, Func&& func)
+{
+	const ReferenceMap& referenceMap = object->GetTypeInfo().GetReferenceMap();
+	char* base = reinterpret_cast<char*>(object);
+
+	for (size_t offset : referenceMap.WeakOffsets)
+	{
+		func(reinterpret_cast<GCObject**>(base + offset));
+	}
+
+	for (const ContainerReference& container : referenceMap.WeakContainers)
+	{
+		void* ptr = base + container.Offset;
+
+		if (GCObject** data = static_cast<GCObject**>(container.IteratorHandler->GetData(ptr)))
+		{
+			const size_t count = container.IteratorHandler->GetCount(ptr);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				func(data + i);
+			}
+		}
+		else
+		{
+			auto iter = container.IteratorHandler->Begin(ptr);
+			auto end = container.IteratorHandler->End(ptr);
+
+			while (*iter != *end)
+			{
+				func(static_cast<GCObject**>(iter->Dereference()));
+				iter->Increment();
+			}
+		}
+	}
+}
+
+template <typename Func>
+bool GCManager::scanConcurrent(GCObject* object, Func&& markChild)
+{
+	if (GCHeap::IsScanned(object))
+	{
+		return false;
+	}
+
+	std::lock_guard<GCSpinLock> lock(mScanLocks[(reinterpret_cast<uintptr_t>(object) / GCHeap::SLOT_ALIGNMENT) % SCAN_LOCK_COUNT]);
+
+	if (GCHeap::IsScanned(object))
+	{
+		return false;
+	}
+
+	forEachReference(object, [&markChild](GCObject** slot) {
+		GCObject* child = *slot;
+
+		if (child != nullptr && child->atomicMark())
+		{
+			markChild(child);
+		}
+		});
+
+	// 다 읽은 뒤에 표시해야 표시를 본 변경자가 읽는 중인 컨테이너를 바꾸지 않는다
+	GCHeap::SetScanned(object);
+	return true;
+}
+
+template <typename Func>
+void GCManager::forEachStackRootSlot(Func&& func)
+{
+	for (GCObject** slot : mRootStack.Slots)
+	{
+		func(slot);
+	}
+
+	// 끝난 스레드의 캐시는 스택이 비어 있고, 안전 구간의 스레드는 GCRoot 를 만들거나 지우지 않는다
+	for (GCThreadCache* cache = mThreadCaches.load(std::memory_order_acquire); cache != nullptr; cache = cache->Next)
+	{
+		for (GCObject** slot : cache->RootStack.Slots)
+		{
+			func(slot);
+		}
+	}
+}
+
+template <typename Func>
+size_t GCManager::forEachRoot(Func&& func)
+{
+	for (GCObject* root : mRootObjects)
+	{
+		func(root);
+	}
+
+	size_t stackRootCount = 0;
+
+	forEachStackRootSlot([&func, &stackRootCount](GCObject** slot) {
+		if (*slot != nullptr)
+		{
+			func(*slot);
+			++stackRootCount;
+		}
+		});
+
+	return stackRootCount;
+}
+
+GCManager::GCManager()
+	: mInstanceIndex(++mInstanceCount)
+	, mFinalizer(std::make_unique<GCFinalizer>(mHeap))
+{
+	Property::SetWriteBarrier(&GCManager::propertyWriteBarrier);
+
+	// Create 를 호출한 스레드가 변경자 스레드
+	mThreadCache.InstanceIndex = mInstanceIndex;
+	mThreadCache.Cache = nullptr;
+}
 
 GCManager::~GCManager()
 {
+	Property::SetWriteBarrier(nullptr);
+
+	abortIncrementalCycle();
+	FinishSweep();
+	mergeThreadObjects();
+	promoteAllYoungObjects();
+
 	const size_t OBJECT_COUNT = mGCObjects.GetSize();
 
 	for (int i = static_cast<int>(OBJECT_COUNT) - 1; i >= 0; --i)
 	{
-		delete mGCObjects[i];
+		destroyObject(mGCObjects[i]);
 		mGCObjects[i] = nullptr;
 		mGCObjects.RemoveLast();
 	}
+
+	// 버퍼에 남은 슬롯은 힙과 함께 해제된다
+	GCThreadCache* cache = mThreadCaches.exchange(nullptr, std::memory_order_acquire);
+
+	while (cache != nullptr)
+	{
+		GCThreadCache* next = cache->Next;
+		delete cache;
+		cache = next;
+	}
 }
 
 void GCManager::Collect()
 {
+	SafepointScope safepoint(*this);
+
+	collectFull();
+	publishDebugInfo();
+}
+
+void GCManager::collectFull()
+{
+	abortIncrementalCycle();
+	mergeThreadObjects();
 	mMaxDepth.store(0, std::memory_order_relaxed);
 
 	using namespace std::chrono;
 
-	auto startTime = high_resolution_clock::now(); // ü ð  
+	auto startTime = high_resolution_clock::now(); // 전체 시간 측정 시작
+
+	mLastDebugInfo = GCDebugInfo();
+	mLastDebugInfo.Mode = GCCollectionMode::Full;
+	mLastDebugInfo.StartTime = startTime;
+
+	// 전체 수집은 두 세대를 함께 처리하고, 살아남은 객체는 모두 올드 세대가 된다
+	const size_t promotedCount = mYoungObjects.GetSize();
+	promoteAllYoungObjects();
 
 	const size_t objectCount = mGCObjects.GetSize();
 	size_t deletedCount = 0;
-	size_t rootCount = 0;
+	size_t freedBytes = 0;
 
-	std::vector<GCObject*> rootObjects;
-	rootObjects.reserve(128);
+	//-------------------- ROOT SCAN --------------------
+	mHeap.ClearMarkBits();
+
+	// 루트는 SetRoot 와 GCRoot 에서 등록되므로 전체 객체를 훑지 않는다
+	// 스택이 넘쳐도 루트는 마킹되어 있으므로 recoverMarkStackOverflow 에서 이어서 따라간다
+	const size_t stackRootCount = forEachRoot([this](GCObject* root) {
+		if (root->atomicMark())
+		{
+			mMarkStack.Push(root, 1);
+		}
+		});
+	const size_t rootCount = mRootObjects.size() + stackRootCount;
 
-	//-------------------- MARK --------------------
 	auto markStart = high_resolution_clock::now();
 
-	for (size_t i = 0; i < objectCount; ++i)
-	{
-		mGCObjects[i]->setMarked(false);
+	//-------------------- MARK --------------------
+	drainMarkStack();
 
-		if (mGCObjects[i]->IsRoot())
-		{
-			rootObjects.push_back(mGCObjects[i]);
-			++rootCount;
-		}
-	}
+	const size_t markStackOverflows = recoverMarkStackOverflow();
 
-	for (GCObject* root : rootObjects)
-	{
-		markFrom(root);
-	}
+	// 죽을 객체를 가리키는 약한 참조는 소멸되기 전에 한꺼번에 비운다
+	const size_t clearedWeakCount = clearWeakReferences(false);
 
-	auto markEnd = high_resolution_clock::now();
-	auto markMs = duration_cast<milliseconds>(markEnd - markStart).count();
-	auto markUs = duration_cast<microseconds>(markEnd - markStart).count();
+	auto sweepStart = high_resolution_clock::now();
 
 	//-------------------- SWEEP --------------------
-	auto sweepStart = high_resolution_clock::now();
+	const bool bTypeCensus = mSettings.bTypeCensus;
+
+	if (bTypeCensus)
+	{
+		mTypeCensus.Reset();
+	}
 
+	// 마크 비트맵을 먼저 확인해 살아있는 객체의 캐시 라인은 읽지 않는다 (census 를 켜면 타입을 읽는다)
 	for (int i = static_cast<int>(objectCount) - 1; i >= 0; --i)
 	{
-		if (mGCObjects[i]->IsRoot())
+		if (mGCObjects[i]->isMarked() || mGCObjects[i]->IsRoot())
 		{
+			if (bTypeCensus)
+			{
+				mTypeCensus.AddLive(mGCObjects[i]->GetTypeInfo(), GCHeap::GetAllocationSize(mGCObjects[i]));
+			}
+
 			continue;
 		}
-		if (mGCObjects[i]->isMarked())
+
+		if (bTypeCensus)
 		{
-			continue;
+			mTypeCensus.AddFreed(mGCObjects[i]->GetTypeInfo(), GCHeap::GetAllocationSize(mGCObjects[i]));
 		}
 
-		delete mGCObjects[i];
+		freedBytes += GCHeap::GetAllocationSize(mGCObjects[i]);
+		sweepObject(mGCObjects[i]);
 		mGCObjects[i] = nullptr;
 		mGCObjects.RemoveAtSwapLast(i);
 		++deletedCount;
 	}
 
-	auto sweepEnd = high_resolution_clock::now();
-	auto sweepMs = duration_cast<milliseconds>(sweepEnd - sweepStart).count();
-	auto sweepUs = duration_cast<microseconds>(sweepEnd - sweepStart).count();
+	if (mPendingSweepCount == 0)
+	{
+		mHeap.ReleaseEmptyPages();
+	}
+
+	auto finalizeStart = high_resolution_clock::now();
 
-	//--------------------   --------------------
-	auto endTime = high_resolution_clock::now();
-	auto totalMs = duration_cast<milliseconds>(endTime - startTime).count();
-	auto totalUs = duration_cast<microseconds>(endTime - startTime).count();
+	//-------------------- FINALIZE --------------------
+	const size_t deferredFinalizeCount = flushFinalizeBatch();
 
-	const size_t remaining = mGCObjects.GetSize();
+	//-------------------- 디버그 정보 --------------------
+	auto endTime = high_resolution_clock::now();
 
-	mLastDebugInfo.DurationMs = totalMs;
-	mLastDebugInfo.DurationUs = totalUs;
+	mLastDebugInfo.DurationUs = duration_cast<microseconds>(endTime - startTime).count();
+	mLastDebugInfo.DurationMs = mLastDebugInfo.DurationUs / 1000;
+	mLastDebugInfo.RootScanUs = duration_cast<microseconds>(markStart - startTime).count();
+	mLastDebugInfo.MarkUs = duration_cast<microseconds>(sweepStart - markStart).count();
+	mLastDebugInfo.SweepUs = duration_cast<microseconds>(finalizeStart - sweepStart).count();
+	mLastDebugInfo.FinalizeUs = duration_cast<microseconds>(endTime - finalizeStart).count();
 	mLastDebugInfo.TotalObjects = objectCount;
 	mLastDebugInfo.DeletedObjects = deletedCount;
-	mLastDebugInfo.RemainingObjects = remaining;
+	mLastDebugInfo.FreedBytes = freedBytes;
+	mLastDebugInfo.MaxMarkDepth = mMaxDepth.load(std::memory_order_relaxed);
+	mLastDebugInfo.RemainingObjects = mGCObjects.GetSize();
 	mLastDebugInfo.RootObjectCount = rootCount;
-	size_t maxDepth = mMaxDepth.load(std::memory_order_relaxed);
-
-	std::ostringstream oss;
-	oss << "[GC] Start - Mode: " << "Single-threaded\n"
-		<< "[GC] Total Time: " << totalMs << " ms (" << totalUs << " s)\n"
-		<< "  Mark Phase:  " << markMs << " ms (" << markUs << " s)\n"
-		<< "  Sweep Phase: " << sweepMs << " ms (" << sweepUs << " s)\n"
-		<< "[GC] Total objects: " << objectCount << "\n"
-		<< "[GC] Root objects: " << rootCount << "\n"
-		<< "[GC] Deleted objects: " << deletedCount << "\n"
-		<< "[GC] Remaining objects: " << remaining << "\n"
-		<< "[GC] Max Depth: " << maxDepth << "\n";
-
-	OutputDebugStringA(oss.str().c_str());
+	mLastDebugInfo.StackRootCount = stackRootCount;
+	mLastDebugInfo.PendingSweepObjects = mPendingSweepCount;
+	mLastDebugInfo.DeferredFinalizeObjects = deferredFinalizeCount;
+	mLastDebugInfo.ClearedWeakReferences = clearedWeakCount;
+	mLastDebugInfo.MarkStackOverflows = markStackOverflows;
+	mLastDebugInfo.PromotedObjects = promotedCount;
 }
 
 void GCManager::CollectMultiThread()
 {
 	using namespace std::chrono;
 
+	SafepointScope safepoint(*this);
+
+	abortIncrementalCycle();
+	mergeThreadObjects();
+
 	mMaxDepth.store(0, std::memory_order_relaxed);
 
-	struct ValidRange
-	{
-		size_t StartIndex;
-		size_t EndIndex;
-		size_t DeleteCount;
-	};
+	auto startTime = high_resolution_clock::now(); // 전체 시간 측정 시작
+
+	mLastDebugInfo = GCDebugInfo();
+	mLastDebugInfo.Mode = GCCollectionMode::FullMultiThread;
+	mLastDebugInfo.StartTime = startTime;
 
-	auto startTime = high_resolution_clock::now(); // ü ð  
+	const size_t promotedCount = mYoungObjects.GetSize();
+	promoteAllYoungObjects();
 
 	const size_t objectCount = mGCObjects.GetSize();
 	size_t deletedCount = 0;
-	size_t rootCount = 0;
 
-	const size_t threadCount = std::thread::hardware_concurrency() / 2;
-	std::vector<std::future<void>> markFutures;
-	std::vector<std::future<ValidRange>> sweepFutures;
-	markFutures.reserve(threadCount);
-	sweepFutures.reserve(threadCount);
+	const size_t threadCount = mWorkerPool->GetThreadCount();
 
-	std::vector<GCObject*> rootObjects;
-	rootObjects.reserve(128);
 	//-------------------- MARK --------------------
-	auto markStart = high_resolution_clock::now();
-
-	for (size_t i = 0; i < objectCount; ++i)
-	{
-		mGCObjects[i]->setMarked(false);
+	// 루트 스캔 시간은 markParallel 이 RootScanUs 에 기록
+	mHeap.ClearMarkBits();
+	const size_t stackRootCount = markParallel(threadCount);
+	const size_t rootCount = mRootObjects.size() + stackRootCount;
 
-		if (mGCObjects[i]->IsRoot())
-		{
-			rootObjects.push_back(mGCObjects[i]);
-			++rootCount;
-		}
-	}
+	const size_t clearedWeakCount = clearWeakReferences(false);
 
-	const size_t markChunkSize = (rootObjects.size() + threadCount - 1) / threadCount;
+	auto sweepStart = high_resolution_clock::now();
 
-	for (size_t t = 0; t < threadCount; ++t)
+	//-------------------- SWEEP --------------------
+	// 워커는 레지스트리 청크를 하나씩 가져가 살아있는 객체를 청크 앞쪽으로 모은다
+	const size_t chunkCount = mGCObjects.GetChunkCount();
+	std::vector<size_t> liveCounts(chunkCount);
+	std::vector<std::vector<GCObject*>> deadObjects(threadCount);
+	std::atomic<size_t> nextChunk = 0;
+	const bool bTypeCensus = mSettings.bTypeCensus;
+
+	// 워커별 census 에 따로 모으고 끝난 뒤 합친다
+	if (bTypeCensus)
 	{
-		size_t begin = t * markChunkSize;
+		mWorkerTypeCensus.resize(std::max(mWorkerTypeCensus.size(), threadCount));
 
-		if (begin >= rootObjects.size())
+		for (GCTypeCensus& workerCensus : mWorkerTypeCensus)
 		{
-			break;
+			workerCensus.Reset();
 		}
-
-		size_t end = std::min<size_t>(rootObjects.size(), (t + 1) * markChunkSize);
-
-		markFutures.emplace_back(std::async(std::launch::async, [this, &rootObjects, begin, end]() {
-			for (size_t i = begin; i < end; ++i)
-			{
-				markFrom(rootObjects[i]);
-			}
-			}));
 	}
 
-	for (auto& markFuture : markFutures)
-	{
-		markFuture.get();
-	};
+	mWorkerPool->Run([this, chunkCount, bTypeCensus, &liveCounts, &deadObjects, &nextChunk](size_t t) {
+		GCWorkerDebugInfo& workerInfo = mLastDebugInfo.Workers[t];
 
-	auto markEnd = high_resolution_clock::now();
-	auto markMs = duration_cast<milliseconds>(markEnd - markStart).count();
-	auto markUs = duration_cast<microseconds>(markEnd - markStart).count();
-
-	//-------------------- SWEEP --------------------
-	auto sweepStart = high_resolution_clock::now();
+		for (size_t chunkIndex = nextChunk.fetch_add(1, std::memory_order_relaxed); chunkIndex < chunkCount;
+			chunkIndex = nextChunk.fetch_add(1, std::memory_order_relaxed))
+		{
+			GCObject** chunk = mGCObjects.GetChunk(chunkIndex);
+			const size_t length = mGCObjects.GetChunkLength(chunkIndex);
+			size_t liveCount = 0;
 
-	const size_t sweepChunkSize = (objectCount + threadCount - 1) / threadCount;
+			for (size_t i = 0; i < length; ++i)
+			{
+				GCObject* object = chunk[i];
 
-	for (size_t t = 0; t < threadCount; ++t)
-	{
-		size_t begin = t * sweepChunkSize;
+				if (object->isMarked() || object->IsRoot())
+				{
+					if (bTypeCensus)
+					{
+						mWorkerTypeCensus[t].AddLive(object->GetTypeInfo(), GCHeap::GetAllocationSize(object));
+					}
 
-		if (begin >= objectCount)
-		{
-			break;
-		}
+					chunk[liveCount++] = object;
+					continue;
+				}
 
-		size_t end = std::min<size_t>(objectCount, (t + 1) * sweepChunkSize);
+				if (bTypeCensus)
+				{
+					mWorkerTypeCensus[t].AddFreed(object->GetTypeInfo(), GCHeap::GetAllocationSize(object));
+				}
 
-		sweepFutures.emplace_back(std::async(std::launch::async, [this, begin, end]() -> ValidRange {
-			ValidRange validRange;
-			validRange.StartIndex = begin;
-			validRange.EndIndex = end;
-			validRange.DeleteCount = 0;
+				++workerInfo.SweptObjects;
+				workerInfo.SweptBytes += GCHeap::GetAllocationSize(object);
 
-			for (int i = static_cast<int>(end) - 1; i >= static_cast<int>(begin); --i)
-			{
-				if (mGCObjects[i]->IsRoot())
+				// 지연 스윕, 지연 파이널라이즈 대상은 단일 스레드에서 대기 목록에 넣고, 나머지는 여기서 바로 소멸
+				if (mSettings.bLazySweep || object->mbDeferredFinalization)
 				{
-					continue;
+					deadObjects[t].push_back(object);
 				}
-				if (mGCObjects[i]->isMarked())
+				else
 				{
-					continue;
+					destroyObject(object);
 				}
-
-				delete mGCObjects[i];
-				mGCObjects[i] = nullptr;
-				mGCObjects.Swap(i, end - 1);
-				++validRange.DeleteCount;
 			}
 
-			return validRange;
-			}));
-	}
+			liveCounts[chunkIndex] = liveCount;
+		}
+		});
 
-	size_t destIndex = 0;
+	mGCObjects.CompactChunks(liveCounts);
+	deletedCount = objectCount - mGCObjects.GetSize();
 
-	for (auto& sweepFuture : sweepFutures)
+	if (bTypeCensus)
 	{
-		ValidRange validRange = sweepFuture.get();
-		assert(sweepChunkSize >= validRange.DeleteCount);
+		mTypeCensus.Reset();
 
-		const size_t copyLength = validRange.EndIndex - validRange.StartIndex - validRange.DeleteCount;
-		mGCObjects.MoveChunkByMemcpy(destIndex, validRange.StartIndex, copyLength);
+		for (size_t t = 0; t < threadCount; ++t)
+		{
+			mTypeCensus.Merge(mWorkerTypeCensus[t]);
+		}
+	}
 
-		deletedCount += validRange.DeleteCount;
-		destIndex += copyLength;
-	};
+	for (const std::vector<GCObject*>& workerDeadObjects : deadObjects)
+	{
+		for (GCObject* object : workerDeadObjects)
+		{
+			sweepObject(object);
+		}
+	}
 
-	mGCObjects.ShrinkTo(mGCObjects.GetSize() - deletedCount);
+	if (mPendingSweepCount == 0)
+	{
+		mHeap.ReleaseEmptyPages();
+	}
 
-	auto sweepEnd = high_resolution_clock::now();
-	auto sweepMs = duration_cast<milliseconds>(sweepEnd - sweepStart).count();
-	auto sweepUs = duration_cast<microseconds>(sweepEnd - sweepStart).count();
+	auto finalizeStart = high_resolution_clock::now();
 
-	//--------------------   --------------------
+	//-------------------- FINALIZE --------------------
+	const size_t deferredFinalizeCount = flushFinalizeBatch();
+
+	//-------------------- 디버그 정보 --------------------
 	auto endTime = high_resolution_clock::now();
-	auto totalMs = duration_cast<milliseconds>(endTime - startTime).count();
-	auto totalUs = duration_cast<microseconds>(endTime - startTime).count();
 
-	const size_t remaining = mGCObjects.GetSize();
+	size_t freedBytes = 0;
+
+	for (const GCWorkerDebugInfo& workerInfo : mLastDebugInfo.Workers)
+	{
+		freedBytes += workerInfo.SweptBytes;
+	}
 
-	mLastDebugInfo.DurationMs = totalMs;
-	mLastDebugInfo.DurationUs = totalUs;
+	mLastDebugInfo.DurationUs = duration_cast<microseconds>(endTime - startTime).count();
+	mLastDebugInfo.DurationMs = mLastDebugInfo.DurationUs / 1000;
+	mLastDebugInfo.MarkUs = duration_cast<microseconds>(sweepStart - startTime).count() - mLastDebugInfo.RootScanUs;
+	mLastDebugInfo.SweepUs = duration_cast<microseconds>(finalizeStart - sweepStart).count();
+	mLastDebugInfo.FinalizeUs = duration_cast<microseconds>(endTime - finalizeStart).count();
 	mLastDebugInfo.TotalObjects = objectCount;
 	mLastDebugInfo.DeletedObjects = deletedCount;
-	mLastDebugInfo.RemainingObjects = remaining;
+	mLastDebugInfo.FreedBytes = freedBytes;
+	mLastDebugInfo.RemainingObjects = mGCObjects.GetSize();
 	mLastDebugInfo.RootObjectCount = rootCount;
-	size_t maxDepth = mMaxDepth.load(std::memory_order_relaxed);
-
-	std::ostringstream oss;
-	oss << "[GC] Start - Mode: " << "Multi-threaded : " << threadCount << "\n"
-		<< "[GC] Total Time: " << totalMs << " ms (" << totalUs << " s)\n"
-		<< "  Mark Phase:  " << markMs << " ms (" << markUs << " s)\n"
-		<< "  Sweep Phase: " << sweepMs << " ms (" << sweepUs << " s)\n"
-		<< "[GC] Total objects: " << objectCount << "\n"
-		<< "[GC] Root objects: " << rootCount << "\n"
-		<< "[GC] Deleted objects: " << deletedCount << "\n"
-		<< "[GC] Remaining objects: " << remaining << "\n"
-		<< "[GC] Max Depth: " << maxDepth << "\n";
+	mLastDebugInfo.StackRootCount = stackRootCount;
+	mLastDebugInfo.PendingSweepObjects = mPendingSweepCount;
+	mLastDebugInfo.DeferredFinalizeObjects = deferredFinalizeCount;
+	mLastDebugInfo.ClearedWeakReferences = clearedWeakCount;
+	mLastDebugInfo.PromotedObjects = promotedCount;
 
-	OutputDebugStringA(oss.str().c_str());
+	publishDebugInfo();
 }
 
-void GCManager::markFrom(GCObject* root)
+void GCManager::CollectIncremental(int64_t budgetUs)
 {
-	std::vector<std::pair<GCObject*, size_t>> stack;
-	stack.reserve(POOL_SIZE);
+	using namespace std::chrono;
+
+	// 동시 수집의 마킹 중이면 그쪽으로 이어간다
+	if (mIncrementalPhase == GCPhase::ConcurrentMark)
+	{
+		CollectConcurrent(budgetUs);
+		return;
+	}
 
-	stack.push_back({ root, 1 });
-	root->setMarked(true);
+	SafepointScope safepoint(*this);
 
-	size_t maxDepth = 1;
+	const auto sliceStart = high_resolution_clock::now();
+	const auto deadline = sliceStart + microseconds(budgetUs);
 
-	while (!stack.empty())
+	if (mIncrementalPhase == GCPhase::Idle)
 	{
-		auto [current, depth] = stack.back();
-		stack.pop_back();
-
-		maxDepth = std::max<size_t>(maxDepth, depth);
-		const TypeInfo& typeInfo = current->GetTypeInfo();
+		beginIncrementalCycle();
+		mIncrementalDebugInfo.StartTime = sliceStart;
+		mIncrementalDebugInfo.RootScanUs = duration_cast<microseconds>(high_resolution_clock::now() - sliceStart).count();
+	}
 
-		for (const Property* prop : typeInfo.GetProperties())
-		{
-			void* ptr = prop->GetRawPointer(current);
+	auto phaseStart = high_resolution_clock::now();
+	bool bMarkFinished = false;
 
-			if (prop->GetTypeInfo().IsChildOf<GCObject*>())
-			{
-				GCObject* child = *static_cast<GCObject**>(ptr);
+	if (mIncrementalPhase == GCPhase::Mark)
+	{
+		bMarkFinished = incrementalMarkStep(deadline);
 
-				if (child != nullptr && child->atomicMark())
-				{
-					stack.push_back({ child, depth + 1 });
-				}
-			}
-			else if (prop->GetTypeInfo().IsIterable())
-			{
-				auto iter = prop->CreateIteratorBegin<GCObject*>(ptr);
-				auto end = prop->CreateIteratorEnd<GCObject*>(ptr);
+		auto markEnd = high_resolution_clock::now();
+		mIncrementalDebugInfo.MarkUs += duration_cast<microseconds>(markEnd - phaseStart).count();
+		phaseStart = markEnd;
+	}
 
-				while (*iter != *end)
-				{
-					GCObject* child = *static_cast<GCObject**>(iter->Dereference());
+	if (bMarkFinished)
+	{
+		beginIncrementalSweep();
+	}
 
-					if (child != nullptr && child->atomicMark())
-					{
-						stack.push_back({ child, depth + 1 });
-					}
+	bool bFinished = false;
 
-					iter->Increment();
-				}
-			}
-		}
+	if (mIncrementalPhase == GCPhase::Sweep)
+	{
+		bFinished = incrementalSweepStep(deadline);
+		mIncrementalDebugInfo.SweepUs += duration_cast<microseconds>(high_resolution_clock::now() - phaseStart).count();
 	}
 
-	size_t current = mMaxDepth.load(std::memory_order_relaxed);
-	while (current < maxDepth && !mMaxDepth.compare_exchange_weak(current, maxDepth, std::memory_order_relaxed)) {}
+	recordSlicePause(duration_cast<microseconds>(high_resolution_clock::now() - sliceStart).count());
+
+	if (bFinished)
+	{
+		endIncrementalCycle();
+	}
 }
 
-void GCManager::markFromRecursive(GCObject* object)
+void GCManager::CollectMinor()
 {
-	if (!object || object->isMarked())
+	using namespace std::chrono;
+
+	if (mIncrementalPhase != GCPhase::Idle)
 	{
 		return;
 	}
 
-	object->setMarked(true);
+	SafepointScope safepoint(*this);
+	mergeThreadObjects();
 
-	const TypeInfo& typeInfo = object->GetTypeInfo();
+	auto startTime = high_resolution_clock::now();
+
+	mLastDebugInfo = GCDebugInfo();
+	mLastDebugInfo.Mode = GCCollectionMode::Minor;
+	mLastDebugInfo.StartTime = startTime;
 
-	for (const Property* prop : typeInfo.GetProperties())
+	const size_t youngCount = mYoungObjects.GetSize();
+	size_t rootCount = 0;
+	size_t deletedCount = 0;
+	size_t freedBytes = 0;
+	size_t promotedCount = 0;
+
+	//-------------------- ROOT SCAN --------------------
+	// 영 루트와 기억 집합만 루트로 사용, 올드 객체는 살아있다고 보고 따라가지 않는다
+	mMinorMarkStack.clear();
+
+	for (size_t i = 0; i < youngCount; ++i)
 	{
-		void* ptr = prop->GetRawPointer(object);
+		mYoungObjects[i]->setMarked(false);
+	}
 
-		if (prop->GetTypeInfo().IsChildOf<GCObject*>())
+	// 같은 객체를 여러 GCRoot 가 잡고 있을 수 있으므로 처음 마킹할 때만 쌓는다
+	const size_t stackRootCount = forEachRoot([this, &rootCount](GCObject* root) {
+		if (!root->mbOld && root->atomicMark())
 		{
-			GCObject* child = *static_cast<GCObject**>(ptr);
-			markFromRecursive(child);
+			mMinorMarkStack.push_back(root);
+			++rootCount;
 		}
-		else if (prop->GetTypeInfo().IsIterable())
-		{
-			auto iter = prop->CreateIteratorBegin<GCObject*>(ptr);
-			auto end = prop->CreateIteratorEnd<GCObject*>(ptr);
+		});
 
-			while (*iter != *end)
+	auto markYoungChild = [this](GCObject** slot) {
+		GCObject* child = *slot;
+
+		if (child != nullptr && !child->mbOld && child->atomicMark())
+		{
+			mMinorMarkStack.push_back(child);
+		}
+		};
+
+	for (GCObject* rememberedObject : mRememberedSet)
+	{
+		forEachReference(rememberedObject, markYoungChild);
+	}
+
+	auto markStart = high_resolution_clock::now();
+
+	//-------------------- MARK --------------------
+	while (!mMinorMarkStack.empty())
+	{
+		GCObject* current = mMinorMarkStack.back();
+		mMinorMarkStack.pop_back();
+
+		forEachReference(current, markYoungChild);
+	}
+
+	const size_t clearedWeakCount = clearWeakReferences(true);
+
+	auto sweepStart = high_resolution_clock::now();
+
+	//-------------------- SWEEP --------------------
+	std::vector<GCObject*> promotedObjects;
+
+	for (int i = static_cast<int>(youngCount) - 1; i >= 0; --i)
+	{
+		GCObject* object = mYoungObjects[i];
+
+		if (!object->isMarked() && !object->IsRoot())
+		{
+			freedBytes += GCHeap::GetAllocationSize(object);
+			sweepObject(object);
+			mYoungObjects[i] = nullptr;
+			mYoungObjects.RemoveAtSwapLast(i);
+			++deletedCount;
+			continue;
+		}
+
+		if (++object->mAge >= mSettings.PromotionAge)
+		{
+			promoteObject(object);
+			mYoungObjects.RemoveAtSwapLast(i);
+			promotedObjects.push_back(object);
+			++promotedCount;
+		}
+	}
+
+	if (mPendingSweepCount == 0)
+	{
+		mHeap.ReleaseEmptyPages();
+	}
+
+	//-------------------- REMEMBERED SET --------------------
+	// 여전히 영 객체를 가리키는 올드 객체만 남기고, 방금 승격된 객체도 검사
+	std::erase_if(mRememberedSet, [this](GCObject* object) {
+		if (hasYoungReference(object))
+		{
+			return false;
+		}
+
+		object->mbRemembered = false;
+		return true;
+		});
+
+	for (GCObject* promotedObject : promotedObjects)
+	{
+		if (!promotedObject->mbRemembered && hasYoungReference(promotedObject))
+		{
+			promotedObject->mbRemembered = true;
+			mRememberedSet.push_back(promotedObject);
+		}
+	}
+
+	auto finalizeStart = high_resolution_clock::now();
+
+	//-------------------- FINALIZE --------------------
+	const size_t deferredFinalizeCount = flushFinalizeBatch();
+
+	auto endTime = high_resolution_clock::now();
+
+	mLastDebugInfo.DurationUs = duration_cast<microseconds>(endTime - startTime).count();
+	mLastDebugInfo.DurationMs = mLastDebugInfo.DurationUs / 1000;
+	mLastDebugInfo.RootScanUs = duration_cast<microseconds>(markStart - startTime).count();
+	mLastDebugInfo.MarkUs = duration_cast<microseconds>(sweepStart - markStart).count();
+	mLastDebugInfo.SweepUs = duration_cast<microseconds>(finalizeStart - sweepStart).count();
+	mLastDebugInfo.FinalizeUs = duration_cast<microseconds>(endTime - finalizeStart).count();
+	mLastDebugInfo.TotalObjects = youngCount;
+	mLastDebugInfo.DeletedObjects = deletedCount;
+	mLastDebugInfo.FreedBytes = freedBytes;
+	mLastDebugInfo.RemainingObjects = GetObjectCount();
+	mLastDebugInfo.RootObjectCount = rootCount;
+	mLastDebugInfo.StackRootCount = stackRootCount;
+	mLastDebugInfo.PendingSweepObjects = mPendingSweepCount;
+	mLastDebugInfo.DeferredFinalizeObjects = deferredFinalizeCount;
+	mLastDebugInfo.ClearedWeakReferences = clearedWeakCount;
+	mLastDebugInfo.PromotedObjects = promotedCount;
+	mLastDebugInfo.RememberedSetSize = mRememberedSet.size();
+
+	publishDebugInfo();
+}
+
+void GCManager::CollectCompact()
+{
+	using namespace std::chrono;
+
+	SafepointScope safepoint(*this);
+
+	// 살아있는 객체만 남도록 죽은 객체의 소멸과 파이널라이저까지 끝낸다
+	collectFull();
+
+	auto finishSweepStart = high_resolution_clock::now();
+	FinishSweep();
+	auto compactStart = high_resolution_clock::now();
+
+	const size_t objectCount = mGCObjects.GetSize();
+	const size_t pageCount = mHeap.GetPageCount();
+	const size_t pinnedCount = pinCompactionTargets();
+	const size_t evacuatedPageCount = mHeap.BeginEvacuation(mSettings.CompactOccupancyThreshold);
+
+	//-------------------- MOVE --------------------
+	// 옛 자리의 첫 워드에 새 주소를 남기고, 참조 갱신이 끝날 때까지 옛 슬롯은 반환하지 않는다
+	std::vector<void*> oldSlots;
+
+	for (size_t i = 0; i < objectCount; ++i)
+	{
+		GCObject* object = mGCObjects[i];
+
+		if (!GCHeap::IsEvacuating(object))
+		{
+			continue;
+		}
+
+		void* source = dynamic_cast<void*>(object);
+		void* destination = mHeap.Allocate(GCHeap::GetPage(object)->SlotSize);
+		GCObject* movedObject = reinterpret_cast<GCObject*>(static_cast<char*>(destination) + (reinterpret_cast<char*>(object) - static_cast<char*>(source)));
+
+		object->GetTypeInfo().GetRelocator()(destination, source);
+		*reinterpret_cast<GCObject**>(object) = movedObject;
+
+		mGCObjects[i] = movedObject;
+		oldSlots.push_back(source);
+	}
+
+	//-------------------- FIXUP --------------------
+	// 마킹과 같은 참조 목록을 따라가며 비우는 페이지를 가리키는 참조를 새 주소로 바꾼다
+	auto forward = [](GCObject** slot) {
+		GCObject* child = *slot;
+
+		if (child != nullptr && GCHeap::IsEvacuating(child))
+		{
+			*slot = *reinterpret_cast<GCObject**>(child);
+		}
+		};
+
+	for (size_t i = 0; i < objectCount; ++i)
+	{
+		forEachReference(mGCObjects[i], forward);
+		forEachWeakReference(mGCObjects[i], forward);
+	}
+
+	for (GCObject*& weakOwner : mWeakOwners)
+	{
+		forward(&weakOwner);
+	}
+
+	// GCRoot 는 슬롯 주소를 알고 있으므로 고정하지 않고 새 주소로 바꾼다
+	forEachStackRootSlot(forward);
+
+	mHeap.EndEvacuation();
+
+	for (void* oldSlot : oldSlots)
+	{
+		mHeap.Free(oldSlot);
+	}
+
+	mHeap.ReleaseEmptyPages();
+
+	auto compactEnd = high_resolution_clock::now();
+
+	mLastDebugInfo.Mode = GCCollectionMode::Compact;
+	mLastDebugInfo.FinalizeUs += duration_cast<microseconds>(compactStart - finishSweepStart).count();
+	mLastDebugInfo.CompactUs = duration_cast<microseconds>(compactEnd - compactStart).count();
+	mLastDebugInfo.DurationUs = duration_cast<microseconds>(compactEnd - mLastDebugInfo.StartTime).count();
+	mLastDebugInfo.DurationMs = mLastDebugInfo.DurationUs / 1000;
+	mLastDebugInfo.PendingSweepObjects = 0;
+	mLastDebugInfo.MovedObjects = oldSlots.size();
+	mLastDebugInfo.PinnedObjects = pinnedCount;
+	mLastDebugInfo.EvacuatedPages = evacuatedPageCount;
+	mLastDebugInfo.ReleasedPages = pageCount - mHeap.GetPageCount();
+
+	publishDebugInfo();
+}
+
+void GCManager::publishDebugInfo()
+{
+	const auto now = std::chrono::high_resolution_clock::now();
+
+	// 증분, 동시 수집은 시작할 때 이유를 기록해 두고 세이프포인트 대기는 슬라이스마다 기록한다
+	if (mLastDebugInfo.Mode != GCCollectionMode::Incremental && mLastDebugInfo.Mode != GCCollectionMode::Concurrent)
+	{
+		mLastDebugInfo.TriggerReason = mTriggerReason;
+		mLastDebugInfo.TimeToSafepointUs = mTimeToSafepointUs;
+		mLastDebugInfo.SafepointThreadCount = mSafepointThreadCount;
+	}
+
+	mLastDebugInfo.AllocatedBytes = mAllocatedBytes;
+	mLastDebugInfo.AllocatedObjects = mAllocatedObjects;
+	mLastDebugInfo.CommittedBytes = mHeap.GetCommittedBytes();
+	mLastDebugInfo.ReservedBytes = mHeap.GetReservedBytes();
+
+	const size_t heapBytesBefore = mHeapBytes;
+	mHeapBytes -= std::min(mHeapBytes, mLastDebugInfo.FreedBytes);
+
+	if (mLastDebugInfo.Mode != GCCollectionMode::Minor)
+	{
+		mHeapBytesAfterFull = mHeapBytes;
+		mFullPauseUs = mLastDebugInfo.DurationUs;
+		mFullPauseHeapBytes = heapBytesBefore;
+
+		if (mLastDebugInfo.Mode == GCCollectionMode::Incremental)
+		{
+			mIncrementalCycleUs = std::chrono::duration_cast<std::chrono::microseconds>(now - mLastDebugInfo.StartTime).count();
+		}
+	}
+
+	mAllocatedBytes = 0;
+	mAllocatedObjects = 0;
+	mLastCollectionEndTime = now;
+
+	mLastDebugInfo.CycleIndex = ++mCollectionCount;
+	mDebugInfoHistory.Push(mLastDebugInfo);
+
+	if (mDebugInfoListener)
+	{
+		mDebugInfoListener(mLastDebugInfo);
+	}
+}
+
+bool GCManager::CollectIfNeeded()
+{
+	const GCTriggerPolicy& policy = mSettings.TriggerPolicy;
+
+	// 다른 스레드의 할당도 한도 계산에 넣는다
+	mergeThreadObjects();
+
+	// 진행 중인 증분 수집은 시작한 이유를 유지한 채 이어간다
+	if (mIncrementalPhase != GCPhase::Idle)
+	{
+		CollectIncremental(policy.IncrementalSliceUs);
+		return true;
+	}
+
+	const size_t heapTriggerBytes = GetHeapTriggerBytes();
+	const bool bIncremental = policy.PauseGoalUs > 0 && predictFullPauseUs() > policy.PauseGoalUs;
+
+	if (mHeapBytes >= heapTriggerBytes)
+	{
+		mTriggerReason = GCTriggerReason::HeapGrowth;
+	}
+	else if (bIncremental && isAllocationOutpacing(heapTriggerBytes))
+	{
+		mTriggerReason = GCTriggerReason::AllocationRate;
+	}
+	else if (policy.YoungAllocationBudget > 0 && mAllocatedBytes >= policy.YoungAllocationBudget)
+	{
+		mTriggerReason = GCTriggerReason::YoungAllocation;
+	}
+	else
+	{
+		return false;
+	}
+
+	if (mTriggerReason == GCTriggerReason::YoungAllocation)
+	{
+		CollectMinor();
+	}
+	else if (bIncremental)
+	{
+		CollectIncremental(policy.IncrementalSliceUs);
+	}
+	else if (mWorkerPool->GetThreadCount() > 1)
+	{
+		CollectMultiThread();
+	}
+	else
+	{
+		Collect();
+	}
+
+	mTriggerReason = GCTriggerReason::Manual;
+	return true;
+}
+
+int64_t GCManager::predictFullPauseUs() const
+{
+	if (mFullPauseHeapBytes == 0)
+	{
+		return mFullPauseUs;
+	}
+
+	return static_cast<int64_t>(static_cast<double>(mFullPauseUs) * mHeapBytes / mFullPauseHeapBytes);
+}
+
+bool GCManager::isAllocationOutpacing(size_t heapTriggerBytes) const
+{
+	const double pacing = mSettings.TriggerPolicy.AllocationRatePacing;
+
+	// 증분 수집을 한 번도 끝내지 않았으면 걸리는 시간을 모른다
+	if (pacing <= 0.0 || mIncrementalCycleUs == 0)
+	{
+		return false;
+	}
+
+	const int64_t elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - mLastCollectionEndTime).count();
+	const double bytesPerUs = static_cast<double>(mAllocatedBytes) / std::max<int64_t>(1, elapsedUs);
+	const double expectedBytes = bytesPerUs * mIncrementalCycleUs * pacing;
+
+	return mHeapBytes + expectedBytes >= heapTriggerBytes;
+}
+
+std::string GCManager::FormatDebugInfo(const GCDebugInfo& info)
+{
+	static const char* MODE_NAMES[] = { "Single-threaded", "Multi-threaded", "Incremental", "Minor", "Compact", "Concurrent" };
+	static const char* TRIGGER_NAMES[] = { "Manual", "Heap growth", "Allocation rate", "Young allocation" };
+
+	std::ostringstream oss;
+	oss << "[GC] #" << info.CycleIndex << " Mode: " << MODE_NAMES[static_cast<size_t>(info.Mode)]
+		<< ", trigger: " << TRIGGER_NAMES[static_cast<size_t>(info.TriggerReason)] << "\n"
+		<< "[GC] Allocated since last: " << info.AllocatedObjects << " objects (" << info.AllocatedBytes << " bytes)\n"
+		<< "[GC] Total Time: " << info.DurationMs << " ms (" << info.DurationUs << " us)\n"
+		<< " └─ Root Scan:     " << info.RootScanUs << " us\n"
+		<< " └─ Mark Phase:    " << info.MarkUs << " us\n"
+		<< " └─ Sweep Phase:   " << info.SweepUs << " us\n"
+		<< " └─ Finalize:      " << info.FinalizeUs << " us\n"
+		<< " └─ Compact Phase: " << info.CompactUs << " us\n"
+		<< "[GC] Total objects: " << info.TotalObjects << "\n"
+		<< "[GC] Root objects: " << info.RootObjectCount << " (GCRoot " << info.StackRootCount << ")\n"
+		<< "[GC] Deleted objects: " << info.DeletedObjects << " (" << info.FreedBytes << " bytes)\n"
+		<< "[GC] Remaining objects: " << info.RemainingObjects << "\n"
+		<< "[GC] Pending sweep objects: " << info.PendingSweepObjects << "\n"
+		<< "[GC] Deferred finalize objects: " << info.DeferredFinalizeObjects << "\n"
+		<< "[GC] Cleared weak references: " << info.ClearedWeakReferences << "\n"
+		<< "[GC] Committed: " << info.CommittedBytes << " bytes, reserved: " << info.ReservedBytes << " bytes\n"
+		<< "[GC] Max Depth: " << info.MaxMarkDepth << ", mark stack overflows: " << info.MarkStackOverflows << "\n";
+
+	if (info.Mode == GCCollectionMode::Minor)
+	{
+		oss << "[GC] Promoted objects: " << info.PromotedObjects << ", remembered set: " << info.RememberedSetSize << "\n";
+	}
+
+	if (info.SafepointThreadCount > 0)
+	{
+		oss << "[GC] Safepoint: " << info.SafepointThreadCount << " threads stopped in " << info.TimeToSafepointUs << " us\n";
+	}
+
+	if (info.Mode == GCCollectionMode::Concurrent)
+	{
+		oss << "[GC] Background mark: " << info.ConcurrentMarkUs << " us, remark pause: " << info.RemarkUs << " us\n";
+	}
+
+	if (info.Mode == GCCollectionMode::Incremental || info.Mode == GCCollectionMode::Concurrent)
+	{
+		oss << "[GC] Slices: " << info.SliceCount
+			<< " (p50 " << info.SlicePauseP50Us
+			<< " us, p95 " << info.SlicePauseP95Us
+			<< " us, p99 " << info.SlicePauseP99Us
+			<< " us, max " << info.SlicePauseMaxUs << " us)\n";
+	}
+
+	if (info.Mode == GCCollectionMode::Compact)
+	{
+		oss << "[GC] Moved objects: " << info.MovedObjects << ", pinned: " << info.PinnedObjects
+			<< ", evacuated pages: " << info.EvacuatedPages << ", released pages: " << info.ReleasedPages << "\n";
+	}
+
+	if (!info.Workers.empty())
+	{
+		oss << "[GC] Mark packets: " << info.MarkPacketCount << " (size " << info.MarkPacketSize << ")\n";
+	}
+
+	for (size_t i = 0; i < info.Workers.size(); ++i)
+	{
+		const GCWorkerDebugInfo& workerInfo = info.Workers[i];
+
+		oss << "[GC] Worker " << i << ": marked " << workerInfo.MarkedObjects
+			<< ", steals " << workerInfo.StealCount
+			<< ", packets " << workerInfo.ScannedPackets
+			<< ", swept " << workerInfo.SweptObjects << " (" << workerInfo.SweptBytes << " bytes)\n";
+	}
+
+	return oss.str();
+}
+
+void* GCManager::AllocateObject(size_t size)
+{
+	// 다른 스레드는 지연 스윕 대기 목록을 건드리지 않고 자기 버퍼에서만 꺼낸다, 할당량은 병합할 때 더한다
+	if (GCThreadCache* cache = getThreadCache())
+	{
+		return mHeap.AllocateLocal(size, cache->AllocationBuffer);
+	}
+
+	// 할당하는 쪽이 스윕 비용을 조금씩 나눠 내고, 같은 크기 클래스의 슬롯은 버퍼를 다시 채울 때 재사용한다
+	if (mPendingSweepCount > 0)
+	{
+		sweepPending(GCHeap::GetSizeClass(size), LAZY_SWEEP_BATCH);
+	}
+
+	void* memory = mHeap.Allocate(size);
+	const size_t allocationSize = GCHeap::GetAllocationSize(memory);
+
+	mAllocatedBytes += allocationSize;
+	mHeapBytes += allocationSize;
+
+	return memory;
+}
+
+void GCManager::DeallocateObject(void* memory)
+{
+	// 다른 스레드의 할당량은 병합할 때 더하므로 변경자만 되돌린다
+	if (getThreadCache() == nullptr)
+	{
+		const size_t allocationSize = GCHeap::GetAllocationSize(memory);
+
+		mAllocatedBytes -= allocationSize;
+		mHeapBytes -= allocationSize;
+	}
+
+	mHeap.Free(memory);
+}
+
+void GCManager::FinishSweep()
+{
+	while (mPendingSweepCount > 0)
+	{
+		sweepPending(GCHeap::LARGE_SIZE_CLASS, mPendingSweepCount);
+	}
+
+	mFinalizer->Wait();
+}
+
+size_t GCManager::flushFinalizeBatch()
+{
+	const size_t count = mFinalizeBatch.size();
+
+	mFinalizer->Enqueue(std::move(mFinalizeBatch));
+	mFinalizeBatch.clear();
+
+	return count;
+}
+
+void GCManager::AddObject(GCObject* object, bool bDeferredFinalization)
+{
+	object->mbDeferredFinalization = bDeferredFinalization;
+
+	// 증분 수집 중 생성된 객체는 검은색으로 시작
+	const GCPhase phase = mIncrementalPhase.load(std::memory_order_acquire);
+
+	if (phase != GCPhase::Idle)
+	{
+		object->setMarked(true);
+
+		if (phase == GCPhase::ConcurrentMark)
+		{
+			GCHeap::SetScanned(object);
+		}
+	}
+
+	if (GCThreadCache* cache = getThreadCache())
+	{
+		cache->Register(object);
+		return;
+	}
+
+	registerObject(object);
+}
+
+void GCManager::registerObject(GCObject* object)
+{
+	++mAllocatedObjects;
+
+	const ReferenceMap& referenceMap = object->GetTypeInfo().GetReferenceMap();
+
+	if (!referenceMap.WeakOffsets.empty() || !referenceMap.WeakContainers.empty())
+	{
+		mWeakOwners.push_back(object);
+	}
+
+	mYoungObjects.Add(object);
+}
+
+GCThreadCache* GCManager::getThreadCache()
+{
+	ThreadCacheHandle& handle = mThreadCache;
+
+	if (handle.InstanceIndex != mInstanceIndex)
+	{
+		handle.InstanceIndex = mInstanceIndex;
+		handle.Cache = acquireThreadCache();
+	}
+
+	return handle.Cache;
+}
+
+GCThreadCache* GCManager::acquireThreadCache()
+{
+	GCThreadCache* head = mThreadCaches.load(std::memory_order_acquire);
+
+	for (GCThreadCache* cache = head; cache != nullptr; cache = cache->Next)
+	{
+		bool bInUse = false;
+
+		if (!cache->bInUse.load(std::memory_order_relaxed) && cache->bInUse.compare_exchange_strong(bInUse, true, std::memory_order_acquire))
+		{
+			return cache;
+		}
+	}
+
+	GCThreadCache* cache = new GCThreadCache();
+	cache->Next = head;
+
+	while (!mThreadCaches.compare_exchange_weak(cache->Next, cache, std::memory_order_release, std::memory_order_acquire)) {}
+
+	return cache;
+}
+
+void GCManager::releaseThreadCache(GCThreadCache* cache)
+{
+	cache->State.store(GCThreadState::Detached);
+	mHeap.ReleaseBuffer(cache->AllocationBuffer);
+	cache->bInUse.store(false, std::memory_order_release);
+}
+
+void GCManager::RegisterThread()
+{
+	GCThreadCache* cache = getThreadCache();
+	assert(cache != nullptr && "the thread that called GCManager::Create is always stopped by the collector");
+
+	cache->State.store(GCThreadState::Running);
+
+	// 등록 직전에 시작된 정지는 이 스레드를 보지 못했을 수 있다
+	// Safepoint 의 relaxed 읽기가 상태 저장보다 앞서지 않도록 막는다, stopMutatorThreads 의 울타리와 짝
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	Safepoint();
+}
+
+void GCManager::UnregisterThread()
+{
+	GCThreadCache* cache = getThreadCache();
+	assert(cache != nullptr);
+	assert(cache->RootStack.Slots.empty() && "GCRoot must not outlive the registration of its thread");
+
+	cache->State.store(GCThreadState::Detached);
+}
+
+GCRootStack& GCManager::getRootStack()
+{
+	GCThreadCache* cache = getThreadCache();
+
+	if (cache == nullptr)
+	{
+		return mRootStack;
+	}
+
+	// 등록하지 않은 스레드는 수집기가 기다리지 않으므로 스택을 읽는 동안 바뀔 수 있다
+	assert(cache->State.load(std::memory_order_relaxed) != GCThreadState::Detached && "call GCManager::RegisterThread before using GCRoot");
+	return cache->RootStack;
+}
+
+void GCManager::EnterSafeRegion()
+{
+	GCThreadCache* cache = getThreadCache();
+	assert(cache != nullptr && cache->State.load(std::memory_order_relaxed) == GCThreadState::Running);
+
+	cache->State.store(GCThreadState::SafeRegion);
+}
+
+void GCManager::LeaveSafeRegion()
+{
+	GCThreadCache* cache = getThreadCache();
+	assert(cache != nullptr && cache->State.load(std::memory_order_relaxed) == GCThreadState::SafeRegion);
+
+	// 상태를 먼저 바꾸고 요청을 확인해야 수집기가 이 스레드를 멈춘 것으로 본 뒤에 객체를 건드리지 않는다
+	// 약한 메모리 모델에서도 두 순서가 뒤바뀌지 않도록 울타리를 둔다
+	cache->State.store(GCThreadState::Running);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	Safepoint();
+}
+
+void GCManager::parkAtSafepoint()
+{
+	GCThreadCache* cache = getThreadCache();
+
+	if (cache == nullptr)
+	{
+		return;
+	}
+
+	// 등록하지 않은 스레드가 불러도 함께 기다린다
+	const GCThreadState state = cache->State.load(std::memory_order_relaxed);
+
+	if (state == GCThreadState::SafeRegion)
+	{
+		return;
+	}
+
+	do
+	{
+		cache->State.store(GCThreadState::Parked);
+		mbSafepointRequested.wait(true);
+		cache->State.store(state);
+	} while (mbSafepointRequested.load());
+}
+
+void GCManager::stopMutatorThreads()
+{
+	assert(getThreadCache() == nullptr && "collections run on the thread that called GCManager::Create");
+
+	const auto start = std::chrono::high_resolution_clock::now();
+	size_t threadCount = 0;
+
+	// 요청을 먼저 쓰고 상태를 읽는다, 변경자의 상태 저장 -> 요청 읽기와 짝을 이뤄 둘 중 하나는 상대를 본다
+	mbSafepointRequested.store(true);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	for (GCThreadCache* cache = mThreadCaches.load(std::memory_order_acquire); cache != nullptr; cache = cache->Next)
+	{
+		const GCThreadState state = cache->State.load();
+
+		// 이전 정지에서 아직 깨어나지 않은 스레드도 멈춰 있는 것으로 센다
+		if (state != GCThreadState::Running && state != GCThreadState::Parked)
+		{
+			continue;
+		}
+
+		++threadCount;
+
+		while (cache->State.load() == GCThreadState::Running)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	mTimeToSafepointUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+	mSafepointThreadCount = threadCount;
+}
+
+void GCManager::resumeMutatorThreads()
+{
+	mbSafepointRequested.store(false);
+	mbSafepointRequested.notify_all();
+}
+
+void GCManager::recordSlicePause(int64_t pauseUs)
+{
+	mSlicePausesUs.push_back(pauseUs);
+	mIncrementalDebugInfo.TimeToSafepointUs = std::max(mIncrementalDebugInfo.TimeToSafepointUs, mTimeToSafepointUs);
+	mIncrementalDebugInfo.SafepointThreadCount = std::max(mIncrementalDebugInfo.SafepointThreadCount, mSafepointThreadCount);
+}
+
+void GCManager::mergeThreadObjects()
+{
+	for (GCThreadCache* cache = mThreadCaches.load(std::memory_order_acquire); cache != nullptr; cache = cache->Next)
+	{
+		GCRegistrationBlock* previous = nullptr;
+		GCRegistrationBlock* block = cache->Blocks.load(std::memory_order_acquire);
+
+		while (block != nullptr)
+		{
+			const uint32_t count = block->Count.load(std::memory_order_acquire);
+
+			for (uint32_t i = block->MergedCount; i < count; ++i)
+			{
+				GCObject* object = block->Objects[i];
+				const size_t allocationSize = GCHeap::GetAllocationSize(object);
+
+				mAllocatedBytes += allocationSize;
+				mHeapBytes += allocationSize;
+				registerObject(object);
+			}
+
+			block->MergedCount = count;
+
+			// 가장 최근 블록은 소유 스레드가 계속 쓰므로 남기고, 다 옮긴 이전 블록은 해제
+			GCRegistrationBlock* next = block->Next;
+
+			if (previous != nullptr && count == GCRegistrationBlock::CAPACITY)
+			{
+				previous->Next = next;
+				delete block;
+			}
+			else
+			{
+				previous = block;
+			}
+
+			block = next;
+		}
+	}
+}
+
+void GCManager::promoteAllYoungObjects()
+{
+	const size_t youngCount = mYoungObjects.GetSize();
+
+	for (size_t i = 0; i < youngCount; ++i)
+	{
+		promoteObject(mYoungObjects[i]);
+	}
+
+	mYoungObjects.ShrinkTo(0);
+
+	// 영 객체가 남지 않으므로 기억 집합도 비운다
+	for (GCObject* object : mRememberedSet)
+	{
+		object->mbRemembered = false;
+	}
+
+	mRememberedSet.clear();
+}
+
+void GCManager::promoteObject(GCObject* object)
+{
+	object->mbOld = true;
+	mGCObjects.Add(object);
+}
+
+bool GCManager::hasYoungReference(GCObject* object)
+{
+	bool bFound = false;
+
+	forEachReference(object, [&bFound](GCObject** slot) {
+		GCObject* child = *slot;
+		bFound |= (child != nullptr && !child->mbOld);
+		});
+
+	return bFound;
+}
+
+void GCManager::beginIncrementalCycle()
+{
+	mergeThreadObjects();
+	promoteAllYoungObjects();
+
+	const size_t objectCount = mGCObjects.GetSize();
+
+	mIncrementalDebugInfo = GCDebugInfo();
+	mIncrementalDebugInfo.Mode = GCCollectionMode::Incremental;
+	mIncrementalDebugInfo.TriggerReason = mTriggerReason;
+	mIncrementalDebugInfo.TotalObjects = objectCount;
+	mSlicePausesUs.clear();
+	mGreyObjects.clear();
+
+	{
+		std::lock_guard<GCSpinLock> lock(mSatbLock);
+		mSatbBuffer.clear();
+	}
+
+	mHeap.ClearMarkBits();
+
+	const size_t stackRootCount = forEachRoot([this](GCObject* root) {
+		shadeObject(root);
+		});
+
+	mIncrementalDebugInfo.RootObjectCount = mRootObjects.size() + stackRootCount;
+	mIncrementalDebugInfo.StackRootCount = stackRootCount;
+
+	mIncrementalPhase = GCPhase::Mark;
+	mbWriteBarrierActive.store(true, std::memory_order_relaxed);
+}
+
+bool GCManager::incrementalMarkStep(std::chrono::high_resolution_clock::time_point deadline)
+{
+	size_t processedCount = 0;
+
+	while (!mGreyObjects.empty() || takeSatbBuffer(mGreyObjects))
+	{
+		GCObject* current = mGreyObjects.back();
+		mGreyObjects.pop_back();
+
+		forEachReference(current, [this](GCObject** slot) {
+			GCObject* child = *slot;
+
+			if (child != nullptr && child->atomicMark())
+			{
+				mGreyObjects.push_back(child);
+			}
+			});
+
+		if (++processedCount % INCREMENTAL_CHECK_INTERVAL == 0 && std::chrono::high_resolution_clock::now() >= deadline)
+		{
+			return mGreyObjects.empty() && !mbSatbPending.load(std::memory_order_relaxed);
+		}
+	}
+
+	return true;
+}
+
+bool GCManager::incrementalSweepStep(std::chrono::high_resolution_clock::time_point deadline)
+{
+	size_t processedCount = 0;
+
+	// 커서 뒤쪽에 추가된 객체(수집 중 생성)는 방문하지 않는다
+	while (mSweepCursor > 0)
+	{
+		const size_t index = --mSweepCursor;
+		GCObject* object = mGCObjects[index];
+
+		if (mSettings.bTypeCensus)
+		{
+			if (object->isMarked() || object->IsRoot())
+			{
+				mTypeCensus.AddLive(object->GetTypeInfo(), GCHeap::GetAllocationSize(object));
+			}
+			else
+			{
+				mTypeCensus.AddFreed(object->GetTypeInfo(), GCHeap::GetAllocationSize(object));
+			}
+		}
+
+		if (!object->isMarked() && !object->IsRoot())
+		{
+			mIncrementalDebugInfo.FreedBytes += GCHeap::GetAllocationSize(object);
+			sweepObject(object);
+			mGCObjects[index] = nullptr;
+			mGCObjects.RemoveAtSwapLast(index);
+			++mIncrementalDebugInfo.DeletedObjects;
+		}
+
+		if (++processedCount % INCREMENTAL_CHECK_INTERVAL == 0 && std::chrono::high_resolution_clock::now() >= deadline)
+		{
+			return mSweepCursor == 0;
+		}
+	}
+
+	return true;
+}
+
+void GCManager::beginIncrementalSweep()
+{
+	// 회색 객체가 모두 처리되면 흰 객체는 도달 불가능, 스윕 중에는 장벽이 필요 없다
+	mbWriteBarrierActive.store(false, std::memory_order_relaxed);
+	mIncrementalPhase = GCPhase::Sweep;
+	mSweepCursor = mGCObjects.GetSize();
+	mIncrementalDebugInfo.ClearedWeakReferences = clearWeakReferences(false);
+
+	if (mSettings.bTypeCensus)
+	{
+		mTypeCensus.Reset();
+	}
+
+	// 스윕될 올드 객체가 기억 집합에 남지 않도록 정리
+	std::erase_if(mRememberedSet, [](GCObject* object) {
+		if (object->isMarked())
+		{
+			return false;
+		}
+
+		object->mbRemembered = false;
+		return true;
+		});
+}
+
+void GCManager::endIncrementalCycle()
+{
+	std::vector<int64_t> sortedPauses = mSlicePausesUs;
+	std::sort(sortedPauses.begin(), sortedPauses.end());
+
+	auto percentile = [&sortedPauses](size_t percent) -> int64_t {
+		const size_t index = (sortedPauses.size() - 1) * percent / 100;
+		return sortedPauses[index];
+	};
+
+	int64_t totalUs = 0;
+	for (int64_t pauseUs : sortedPauses)
+	{
+		totalUs += pauseUs;
+	}
+
+	mHeap.ReleaseEmptyPages();
+
+	mIncrementalDebugInfo.DurationUs = totalUs;
+	mIncrementalDebugInfo.DurationMs = totalUs / 1000;
+	mIncrementalDebugInfo.RemainingObjects = GetObjectCount();
+	mIncrementalDebugInfo.RememberedSetSize = mRememberedSet.size();
+	mIncrementalDebugInfo.SliceCount = sortedPauses.size();
+	mIncrementalDebugInfo.SlicePauseP50Us = percentile(50);
+	mIncrementalDebugInfo.SlicePauseP95Us = percentile(95);
+	mIncrementalDebugInfo.SlicePauseP99Us = percentile(99);
+	mIncrementalDebugInfo.SlicePauseMaxUs = sortedPauses.back();
+	mIncrementalDebugInfo.SlicePausesUs = mSlicePausesUs;
+
+	const auto finalizeStart = std::chrono::high_resolution_clock::now();
+
+	mIncrementalDebugInfo.PendingSweepObjects = mPendingSweepCount;
+	mIncrementalDebugInfo.DeferredFinalizeObjects = flushFinalizeBatch();
+	mIncrementalDebugInfo.FinalizeUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - finalizeStart).count();
+
+	mLastDebugInfo = mIncrementalDebugInfo;
+	mIncrementalPhase = GCPhase::Idle;
+
+	publishDebugInfo();
+}
+
+void GCManager::abortIncrementalCycle()
+{
+	// 전체 수집이 마크 비트를 다시 계산하므로 진행 중이던 상태만 버린다
+	// 이미 스윕한 객체는 힙 추정치에서 빼 둔다
+	if (mIncrementalPhase == GCPhase::Sweep)
+	{
+		mHeapBytes -= std::min(mHeapBytes, mIncrementalDebugInfo.FreedBytes);
+	}
+
+	// 배경 마킹 워커를 멈추고 남은 회색 객체를 버린다
+	if (mIncrementalPhase == GCPhase::ConcurrentMark)
+	{
+		mbConcurrentMarkAbort.store(true, std::memory_order_relaxed);
+		mWorkerPool->Wait();
+
+		MarkWork work = 0;
+
+		for (std::unique_ptr<WorkStealingQueue<MarkWork>>& queue : mMarkQueues)
+		{
+			while (queue->Pop(work)) {}
+			queue->Reset();
+		}
+	}
+
+	// 변경자 외 스레드의 쓰기 장벽이 남겼을 수 있으므로 증분 수집에서도 비운다
+	{
+		std::lock_guard<GCSpinLock> lock(mSatbLock);
+		mSatbBuffer.clear();
+		mbSatbPending.store(false, std::memory_order_relaxed);
+	}
+
+	mIncrementalPhase = GCPhase::Idle;
+	mbWriteBarrierActive.store(false, std::memory_order_relaxed);
+	mGreyObjects.clear();
+}
+
+void GCManager::shadeObject(GCObject* object)
+{
+	if (!object->atomicMark())
+	{
+		return;
+	}
+
+	// 다른 스레드의 쓰기 장벽은 회색 목록 대신 잠근 버퍼에 남기고, 다음 마킹 슬라이스가 가져간다
+	if (getThreadCache() != nullptr)
+	{
+		std::lock_guard<GCSpinLock> lock(mSatbLock);
+		mSatbBuffer.push_back(object);
+		mbSatbPending.store(true, std::memory_order_relaxed);
+		return;
+	}
+
+	mGreyObjects.push_back(object);
+}
+
+void GCManager::CollectConcurrent(int64_t budgetUs)
+{
+	using namespace std::chrono;
+
+	// 증분 마킹 중이었으면 증분 수집으로 끝낸다
+	if (mIncrementalPhase == GCPhase::Mark || mIncrementalPhase == GCPhase::Sweep)
+	{
+		CollectIncremental(budgetUs);
+		return;
+	}
+
+	// 배경 마킹이 끝나기 전에는 멈추지 않고 돌아간다
+	if (mIncrementalPhase == GCPhase::ConcurrentMark && !mWorkerPool->IsIdle())
+	{
+		return;
+	}
+
+	SafepointScope safepoint(*this);
+	const auto pauseStart = high_resolution_clock::now();
+
+	if (mIncrementalPhase == GCPhase::Idle)
+	{
+		beginConcurrentMark();
+
+		mIncrementalDebugInfo.RootScanUs = duration_cast<microseconds>(high_resolution_clock::now() - pauseStart).count();
+		recordSlicePause(mIncrementalDebugInfo.RootScanUs);
+		return;
+	}
+
+	mWorkerPool->Wait();
+	mIncrementalDebugInfo.ConcurrentMarkUs = duration_cast<microseconds>(pauseStart - mIncrementalDebugInfo.StartTime).count() - mIncrementalDebugInfo.RootScanUs;
+
+	remarkConcurrent();
+
+	mIncrementalDebugInfo.RemarkUs = duration_cast<microseconds>(high_resolution_clock::now() - pauseStart).count();
+	mIncrementalDebugInfo.MarkUs += mIncrementalDebugInfo.RemarkUs;
+	recordSlicePause(mIncrementalDebugInfo.RemarkUs);
+}
+
+void GCManager::beginConcurrentMark()
+{
+	mergeThreadObjects();
+	promoteAllYoungObjects();
+
+	const size_t threadCount = mWorkerPool->GetThreadCount();
+
+	mIncrementalDebugInfo = GCDebugInfo();
+	mIncrementalDebugInfo.Mode = GCCollectionMode::Concurrent;
+	mIncrementalDebugInfo.TriggerReason = mTriggerReason;
+	mIncrementalDebugInfo.StartTime = std::chrono::high_resolution_clock::now();
+	mIncrementalDebugInfo.TotalObjects = mGCObjects.GetSize();
+	mIncrementalDebugInfo.Workers.assign(threadCount, GCWorkerDebugInfo{});
+	mSlicePausesUs.clear();
+
+	{
+		std::lock_guard<GCSpinLock> lock(mSatbLock);
+		mSatbBuffer.clear();
+	}
+
+	mHeap.ClearMarkBits(true);
+
+	while (mMarkQueues.size() < threadCount)
+	{
+		mMarkQueues.emplace_back(std::make_unique<WorkStealingQueue<MarkWork>>(POOL_SIZE / 16));
+	}
+
+	// 스냅샷은 루트만 회색으로 만드는 것으로 끝, 나머지는 배경에서 따라간다
+	size_t rootIndex = 0;
+
+	const size_t stackRootCount = forEachRoot([this, threadCount, &rootIndex](GCObject* root) {
+		if (root->atomicMark())
+		{
+			mMarkQueues[rootIndex++ % threadCount]->Push(reinterpret_cast<MarkWork>(root));
+		}
+		});
+
+	mIncrementalDebugInfo.RootObjectCount = mRootObjects.size() + stackRootCount;
+	mIncrementalDebugInfo.StackRootCount = stackRootCount;
+
+	mIdleMarkWorkerCount.store(0, std::memory_order_relaxed);
+	mbSatbPending.store(false, std::memory_order_relaxed);
+	mbConcurrentMarkAbort.store(false, std::memory_order_relaxed);
+
+	mIncrementalPhase = GCPhase::ConcurrentMark;
+	mbWriteBarrierActive.store(true, std::memory_order_relaxed);
+
+	mWorkerPool->RunAsync([this, threadCount](size_t t) {
+		concurrentMarkWorker(t, threadCount);
+		});
+}
+
+void GCManager::concurrentMarkWorker(size_t workerIndex, size_t threadCount)
+{
+	WorkStealingQueue<MarkWork>& queue = *mMarkQueues[workerIndex];
+	GCWorkerDebugInfo& workerInfo = mIncrementalDebugInfo.Workers[workerIndex];
+	MarkWork work = 0;
+
+	// 변경자가 객체를 바꾸는 중일 수 있으므로 참조 배열을 패킷으로 나누지 않고 객체 단위로 검사한다
+	auto markChild = [&queue](GCObject* child) {
+		queue.Push(reinterpret_cast<MarkWork>(child));
+		};
+
+	while (!mbConcurrentMarkAbort.load(std::memory_order_relaxed))
+	{
+		if (queue.Pop(work) || stealMarkWork(workerIndex, threadCount, work, workerInfo))
+		{
+			if (scanConcurrent(reinterpret_cast<GCObject*>(work), markChild))
+			{
+				++workerInfo.MarkedObjects;
+			}
+
+			continue;
+		}
+
+		if (takeSatbBuffer(queue))
+		{
+			continue;
+		}
+
+		// 모든 워커가 동시에 할 일이 없으면 종료, 이후 변경자가 남기는 회색 객체는 재마킹에서 처리
+		mIdleMarkWorkerCount.fetch_add(1, std::memory_order_acq_rel);
+
+		while (true)
+		{
+			if (mIdleMarkWorkerCount.load(std::memory_order_acquire) == threadCount || mbConcurrentMarkAbort.load(std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			if (hasStealableMarkWork(workerIndex, threadCount) || mbSatbPending.load(std::memory_order_relaxed))
+			{
+				mIdleMarkWorkerCount.fetch_sub(1, std::memory_order_acq_rel);
+				break;
+			}
+
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool GCManager::takeSatbBuffer(WorkStealingQueue<MarkWork>& queue)
+{
+	if (!mbSatbPending.load(std::memory_order_relaxed))
+	{
+		return false;
+	}
+
+	std::vector<GCObject*> batch;
+
+	{
+		std::lock_guard<GCSpinLock> lock(mSatbLock);
+		batch.swap(mSatbBuffer);
+		mbSatbPending.store(false, std::memory_order_relaxed);
+	}
+
+	for (GCObject* object : batch)
+	{
+		queue.Push(reinterpret_cast<MarkWork>(object));
+	}
+
+	return !batch.empty();
+}
+
+bool GCManager::takeSatbBuffer(std::vector<GCObject*>& greyObjects)
+{
+	// 회색 목록이 빌 때만 불리므로 플래그를 보지 않고 잠가서 마킹 종료 직전에 남긴 객체도 놓치지 않는다
+	std::lock_guard<GCSpinLock> lock(mSatbLock);
+
+	greyObjects.insert(greyObjects.end(), mSatbBuffer.begin(), mSatbBuffer.end());
+	mSatbBuffer.clear();
+	mbSatbPending.store(false, std::memory_order_relaxed);
+
+	return !greyObjects.empty();
+}
+
+void GCManager::concurrentWriteBarrier(GCObject* owner, GCObject* newValue)
+{
+	// 영역 객체는 수집기가 따라가지 않으므로 스냅샷을 남길 필요가 없다
+	const bool bScanOwner = owner != nullptr && !GCHeap::IsRegion(owner) && !GCHeap::IsScanned(owner);
+	const bool bShadeNewValue = newValue != nullptr && !GCHeap::IsRegion(newValue) && !GCHeap::IsMarked(newValue);
+
+	// 대부분의 저장은 이미 검사한 owner 에 이미 마킹된 객체를 넣으므로 잠그지 않고 끝난다
+	if (!bScanOwner && !bShadeNewValue)
+	{
+		return;
+	}
+
+	// owner 를 먼저 검사해 두면 워커가 다시 읽지 않으므로 이후 변경과 겹치지 않는다
+	// 검사는 owner 의 줄무늬 잠금만 잡고 지역 버퍼에 모은 뒤 전역 버퍼에는 넘길 때만 잠근다
+	// 재마킹은 모든 스레드를 멈춘 뒤 버퍼를 가져가므로 넘기기 전의 회색 객체를 놓치지 않는다
+	thread_local std::vector<GCObject*> greyBatch;
+	greyBatch.clear();
+
+	if (bScanOwner)
+	{
+		scanConcurrent(owner, [](GCObject* child) {
+			greyBatch.push_back(child);
+			});
+	}
+
+	if (bShadeNewValue && newValue->atomicMark())
+	{
+		greyBatch.push_back(newValue);
+	}
+
+	if (greyBatch.empty())
+	{
+		return;
+	}
+
+	std::lock_guard<GCSpinLock> lock(mSatbLock);
+	mSatbBuffer.insert(mSatbBuffer.end(), greyBatch.begin(), greyBatch.end());
+	mbSatbPending.store(true, std::memory_order_relaxed);
+}
+
+void GCManager::remarkConcurrent()
+{
+	// 워커가 모두 쉬어야 끝나므로 큐는 비어 있고, 변경자가 남긴 객체만 처리하면 된다
+	for (std::unique_ptr<WorkStealingQueue<MarkWork>>& queue : mMarkQueues)
+	{
+		queue->Reset();
+	}
+
+	mGreyObjects.clear();
+
+	{
+		std::lock_guard<GCSpinLock> lock(mSatbLock);
+		mGreyObjects.swap(mSatbBuffer);
+		mbSatbPending.store(false, std::memory_order_relaxed);
+	}
+
+	// 스냅샷 이후 변경자가 GCRoot 로 잡은 객체도 여기서 다시 훑는다
+	forEachRoot([this](GCObject* root) {
+		if (root->atomicMark())
+		{
+			mGreyObjects.push_back(root);
+		}
+		});
+
+	while (!mGreyObjects.empty())
+	{
+		GCObject* current = mGreyObjects.back();
+		mGreyObjects.pop_back();
+
+		scanConcurrent(current, [this](GCObject* child) {
+			mGreyObjects.push_back(child);
+			});
+	}
+
+	beginIncrementalSweep();
+}
+
+void GCManager::setRoot(GCObject* object, bool bRoot)
+{
+	assert(!GCHeap::IsRegion(object) && "GCRegion objects can not be roots, promote them first");
+
+	if (bRoot)
+	{
+		mRootObjects.push_back(object);
+		return;
+	}
+
+	// 루트는 보통 수십 개 이하라 선형 탐색으로 충분
+	auto iter = std::find(mRootObjects.begin(), mRootObjects.end(), object);
+	assert(iter != mRootObjects.end());
+
+	*iter = mRootObjects.back();
+	mRootObjects.pop_back();
+}
+
+GCObject* GCManager::adoptRegionObject(GCObject* object)
+{
+	const TypeInfo& typeInfo = object->GetTypeInfo();
+	assert(typeInfo.GetRelocator() != nullptr && "GCRegion::Promote requires a move constructible type");
+
+	// 압축 수집과 같이 가장 파생된 객체를 옮기고 GCObject 부분의 오프셋을 유지한다
+	const bool bDeferredFinalization = object->mbDeferredFinalization;
+	void* source = dynamic_cast<void*>(object);
+	void* destination = AllocateObject(typeInfo.GetSize());
+	GCObject* movedObject = reinterpret_cast<GCObject*>(static_cast<char*>(destination) + (reinterpret_cast<char*>(object) - static_cast<char*>(source)));
+
+	typeInfo.GetRelocator()(destination, source);
+	AddObject(movedObject, bDeferredFinalization);
+
+	// 증분 수집 중에는 검은색으로 시작하므로 옮겨 온 참조를 쓰기 장벽에 넘긴다
+	if (mbWriteBarrierActive.load(std::memory_order_relaxed))
+	{
+		forEachReference(movedObject, [](GCObject** slot) {
+			if (*slot != nullptr)
+			{
+				WriteBarrier(nullptr, *slot);
+			}
+			});
+	}
+
+	return movedObject;
+}
+
+void GCManager::checkRegionEscape(const GCRegion& region)
+{
+	// 다른 스레드는 힙 목록을 읽을 수 없으므로 변경자 스레드의 영역만 검사한다
+	if (!mSettings.bCheckRegionEscape || getThreadCache() != nullptr)
+	{
+		return;
+	}
+
+	size_t escapedCount = 0;
+
+	auto checkSlot = [&region, &escapedCount](GCObject** slot) {
+		if (*slot != nullptr && region.Contains(*slot))
+		{
+			++escapedCount;
+		}
+		};
+
+	auto checkObjects = [&checkSlot](ChunkedVector<GCObject*>& objects) {
+		const size_t objectCount = objects.GetSize();
+
+		for (size_t i = 0; i < objectCount; ++i)
+		{
+			forEachReference(objects[i], checkSlot);
+			forEachWeakReference(objects[i], checkSlot);
+		}
+		};
+
+	checkObjects(mGCObjects);
+	checkObjects(mYoungObjects);
+
+	forEachStackRootSlot(checkSlot);
+
+	for (GCObject*& root : mRootObjects)
+	{
+		checkSlot(&root);
+	}
+
+	assert(escapedCount == 0 && "a heap object or root still references an object of the GCRegion being released");
+}
+
+size_t GCManager::clearWeakReferences(bool bMinor)
+{
+	size_t clearedCount = 0;
+
+	auto isDead = [bMinor](GCObject* object) {
+		return !(bMinor && object->mbOld) && !object->isMarked() && !object->IsRoot();
+		};
+
+	// 죽은 소유 객체는 목록에서 빼고, 살아있는 소유 객체의 약한 참조만 검사
+	std::erase_if(mWeakOwners, [&isDead, &clearedCount](GCObject* owner) {
+		if (isDead(owner))
+		{
+			return true;
+		}
+
+		forEachWeakReference(owner, [&isDead, &clearedCount](GCObject** slot) {
+			// 영역 객체는 마킹되지 않아 살아 있어도 비워지므로 GCWeakPtr 가 가리킬 수 없다
+			assert(*slot == nullptr || !GCHeap::IsRegion(*slot));
+
+			if (*slot != nullptr && isDead(*slot))
+			{
+				*slot = nullptr;
+				++clearedCount;
+			}
+			});
+
+		return false;
+		});
+
+	return clearedCount;
+}
+
+size_t GCManager::pinCompactionTargets()
+{
+	size_t pinnedCount = 0;
+	const size_t objectCount = mGCObjects.GetSize();
+
+	for (size_t i = 0; i < objectCount; ++i)
+	{
+		GCObject* object = mGCObjects[i];
+		const TypeInfo& typeInfo = object->GetTypeInfo();
+
+		// 네이티브 코드가 주소를 들고 있는 루트, 고정된 객체, 이동 생성할 수 없는 타입
+		if (object->IsRoot() || object->IsPinned() || typeInfo.GetRelocator() == nullptr)
+		{
+			GCHeap::PinPage(object);
+			++pinnedCount;
+		}
+
+		// 정렬, 해시 컨테이너의 원소를 바꾸면 순서가 깨지므로 가리키는 객체를 옮기지 않는다
+		for (const ContainerReference& container : typeInfo.GetReferenceMap().Containers)
+		{
+			if (!container.IteratorHandler->IsAssociative())
+			{
+				continue;
+			}
+
+			void* ptr = reinterpret_cast<char*>(object) + container.Offset;
+			auto iter = container.IteratorHandler->Begin(ptr);
+			auto end = container.IteratorHandler->End(ptr);
+
+			while (*iter != *end)
 			{
-				GCObject* child = *static_cast<GCObject**>(iter->Dereference());
-				markFromRecursive(child);
+				if (GCObject* child = *static_cast<GCObject**>(iter->Dereference()))
+				{
+					GCHeap::PinPage(child);
+					++pinnedCount;
+				}
+
 				iter->Increment();
 			}
 		}
 	}
+
+	return pinnedCount;
+}
+
+void GCManager::destroyObject(GCObject* object)
+{
+	object->~GCObject();
+	mHeap.Free(object);
+}
+
+void GCManager::sweepObject(GCObject* object)
+{
+	if (object->mbDeferredFinalization)
+	{
+		mFinalizeBatch.push_back(object);
+		return;
+	}
+
+	if (!mSettings.bLazySweep)
+	{
+		destroyObject(object);
+		return;
+	}
+
+	mPendingSweep[GCHeap::GetPage(object)->SizeClass].push_back(object);
+	++mPendingSweepCount;
+}
+
+void GCManager::sweepPending(size_t sizeClass, size_t count)
+{
+	size_t bucketIndex = sizeClass;
+
+	while (count > 0 && mPendingSweepCount > 0)
+	{
+		std::vector<GCObject*>& bucket = mPendingSweep[bucketIndex];
+
+		if (bucket.empty())
+		{
+			bucketIndex = (bucketIndex + 1) % mPendingSweep.size();
+			continue;
+		}
+
+		// 소멸자 안에서 새 객체를 만들어도 안전하도록 먼저 꺼낸다
+		GCObject* object = bucket.back();
+		bucket.pop_back();
+		--mPendingSweepCount;
+		--count;
+
+		destroyObject(object);
+	}
+
+	if (mPendingSweepCount == 0)
+	{
+		mHeap.ReleaseEmptyPages();
+	}
+}
+
+void GCManager::propertyWriteBarrier(const Property& property, void* object, [[maybe_unused]] const void* oldValue, const void* newValue)
+{
+	if (!property.GetTypeInfo().IsChildOf<GCObject*>())
+	{
+		return;
+	}
+
+	GCObject* owner = property.GetOwnerTypeInfo().IsChildOf<GCObject>() ? static_cast<GCObject*>(object) : nullptr;
+	WriteBarrier(owner, static_cast<GCObject*>(const_cast<void*>(newValue)));
+}
+
+void GCManager::drainMarkStack()
+{
+	GCPrefetchQueue<GCMarkStack::Entry, MARK_PREFETCH_DISTANCE> prefetchQueue;
+	GCMarkStack::Entry entry;
+	GCMarkStack::Entry scanEntry;
+	size_t maxDepth = 0;
+
+	auto scan = [this, &maxDepth](const GCMarkStack::Entry& current) {
+		maxDepth = std::max<size_t>(maxDepth, current.Depth);
+
+		forEachReference(current.Object, [this, &current](GCObject** slot) {
+			GCObject* child = *slot;
+
+			// 스택이 가득 차면 자식은 마킹만 되고, recoverMarkStackOverflow 에서 이어서 따라간다
+			if (child != nullptr && child->atomicMark())
+			{
+				mMarkStack.Push(child, current.Depth + 1);
+			}
+			});
+		};
+
+	// 꺼낸 객체는 프리페치 후 FIFO 에 넣고, MARK_PREFETCH_DISTANCE 단계 전에 넣은 객체를 검사
+	while (true)
+	{
+		if (mMarkStack.Pop(entry))
+		{
+			GC_PREFETCH(entry.Object);
+
+			if (prefetchQueue.Push(entry, scanEntry))
+			{
+				scan(scanEntry);
+			}
+
+			continue;
+		}
+
+		if (prefetchQueue.Pop(scanEntry))
+		{
+			scan(scanEntry);
+			continue;
+		}
+
+		break;
+	}
+
+	size_t current = mMaxDepth.load(std::memory_order_relaxed);
+	while (current < maxDepth && !mMaxDepth.compare_exchange_weak(current, maxDepth, std::memory_order_relaxed)) {}
+}
+
+size_t GCManager::recoverMarkStackOverflow()
+{
+	size_t overflowCount = 0;
+
+	// 넘친 자식이 어떤 객체인지 모르므로 마킹된 객체를 모두 다시 검사, 이미 마킹된 자식은 건너뛴다
+	while (mMarkStack.HasOverflowed())
+	{
+		mMarkStack.ClearOverflow();
+		++overflowCount;
+
+		const size_t objectCount = mGCObjects.GetSize();
+
+		for (size_t i = 0; i < objectCount; ++i)
+		{
+			if (mGCObjects[i]->isMarked())
+			{
+				mMarkStack.Push(mGCObjects[i], 1);
+				drainMarkStack();
+			}
+		}
+	}
+
+	return overflowCount;
+}
+
+void GCManager::markFromRecursive(GCObject* object)
+{
+	if (!object || object->isMarked())
+	{
+		return;
+	}
+
+	object->setMarked(true);
+
+	forEachReference(object, [this](GCObject** slot) {
+		markFromRecursive(*slot);
+		});
+}
+
+size_t GCManager::markParallel(size_t threadCount)
+{
+	while (mMarkQueues.size() < threadCount)
+	{
+		mMarkQueues.emplace_back(std::make_unique<WorkStealingQueue<MarkWork>>(POOL_SIZE / 16));
+	}
+
+	mMarkPackets.resize(std::max(mMarkPackets.size(), threadCount));
+
+	for (std::deque<GCMarkPacket>& packets : mMarkPackets)
+	{
+		packets.clear();
+	}
+
+	mLastDebugInfo.Workers.assign(threadCount, GCWorkerDebugInfo{});
+	mIdleMarkWorkerCount.store(0, std::memory_order_relaxed);
+
+	// 루트는 골고루 나누어 넣고, 이후 부하는 훔치기로 균형을 맞춘다
+	size_t rootIndex = 0;
+
+	const size_t stackRootCount = forEachRoot([this, threadCount, &rootIndex](GCObject* root) {
+		if (root->atomicMark())
+		{
+			mMarkQueues[rootIndex++ % threadCount]->Push(reinterpret_cast<MarkWork>(root));
+		}
+		});
+
+	mLastDebugInfo.RootScanUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - mLastDebugInfo.StartTime).count();
+
+	mWorkerPool->Run([this, threadCount](size_t t) {
+		markWorker(t, threadCount);
+		});
+
+	mLastDebugInfo.MarkPacketSize = mSettings.MarkPacketSize;
+	mLastDebugInfo.MarkPacketCount = 0;
+
+	for (size_t t = 0; t < threadCount; ++t)
+	{
+		mMarkQueues[t]->Reset();
+		mLastDebugInfo.MarkPacketCount += mLastDebugInfo.Workers[t].CreatedPackets;
+	}
+
+	return stackRootCount;
+}
+
+void GCManager::markWorker(size_t workerIndex, size_t threadCount)
+{
+	WorkStealingQueue<MarkWork>& queue = *mMarkQueues[workerIndex];
+	std::deque<GCMarkPacket>& packets = mMarkPackets[workerIndex];
+	GCWorkerDebugInfo& workerInfo = mLastDebugInfo.Workers[workerIndex];
+	GCPrefetchQueue<GCObject*, MARK_PREFETCH_DISTANCE> prefetchQueue;
+	const size_t packetSize = mSettings.MarkPacketSize;
+	MarkWork work = 0;
+	GCObject* scanObject = nullptr;
+
+	// 작업 훔치기 덱이 필요한 만큼 커지므로 병렬 마킹에는 넘침이 없다
+	auto markChild = [&queue](GCObject* child) {
+		if (child != nullptr && child->atomicMark())
+		{
+			queue.Push(reinterpret_cast<MarkWork>(child));
+		}
+		};
+
+	// 큰 참조 배열은 패킷으로 잘라 넣어 다른 워커가 나눠 가져가게 한다
+	auto scanRange = [&queue, &packets, &workerInfo, &markChild, packetSize](GCObject** data, size_t count) {
+		if (packetSize == 0 || count <= packetSize)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				markChild(data[i]);
+			}
+
+			return;
+		}
+
+		for (size_t begin = 0; begin < count; begin += packetSize)
+		{
+			packets.push_back(GCMarkPacket{ data + begin, std::min(packetSize, count - begin) });
+			queue.Push(reinterpret_cast<MarkWork>(&packets.back()) | MARK_WORK_PACKET_TAG);
+			++workerInfo.CreatedPackets;
+		}
+		};
+
+	auto scan = [&workerInfo, &markChild, &scanRange](GCObject* object) {
+		++workerInfo.MarkedObjects;
+
+		forEachReferenceRange(object, [&markChild](GCObject** slot) { markChild(*slot); }, scanRange);
+		};
+
+	while (true)
+	{
+		if (queue.Pop(work) || stealMarkWork(workerIndex, threadCount, work, workerInfo))
+		{
+			if ((work & MARK_WORK_PACKET_TAG) != 0)
+			{
+				const GCMarkPacket* packet = reinterpret_cast<const GCMarkPacket*>(work & ~MARK_WORK_PACKET_TAG);
+				++workerInfo.ScannedPackets;
+
+				for (size_t i = 0; i < packet->Count; ++i)
+				{
+					markChild(packet->Begin[i]);
+				}
+
+				continue;
+			}
+
+			GCObject* current = reinterpret_cast<GCObject*>(work);
+			GC_PREFETCH(current);
+
+			if (prefetchQueue.Push(current, scanObject))
+			{
+				scan(scanObject);
+			}
+
+			continue;
+		}
+
+		// 쉬기 전에 FIFO 에 남은 객체를 마저 검사
+		if (prefetchQueue.Pop(scanObject))
+		{
+			scan(scanObject);
+			continue;
+		}
+
+		// 모든 워커가 동시에 할 일이 없으면 마킹 종료
+		mIdleMarkWorkerCount.fetch_add(1, std::memory_order_acq_rel);
+
+		while (true)
+		{
+			if (mIdleMarkWorkerCount.load(std::memory_order_acquire) == threadCount)
+			{
+				return;
+			}
+
+			if (hasStealableMarkWork(workerIndex, threadCount))
+			{
+				mIdleMarkWorkerCount.fetch_sub(1, std::memory_order_acq_rel);
+				break;
+			}
+
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool GCManager::stealMarkWork(size_t workerIndex, size_t threadCount, MarkWork& outWork, GCWorkerDebugInfo& workerInfo)
+{
+	for (size_t i = 1; i < threadCount; ++i)
+	{
+		const size_t victimIndex = (workerIndex + i) % threadCount;
+
+		if (mMarkQueues[victimIndex]->Steal(outWork))
+		{
+			++workerInfo.StealCount;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool GCManager::hasStealableMarkWork(size_t workerIndex, size_t threadCount) const
+{
+	for (size_t i = 1; i < threadCount; ++i)
+	{
+		if (!mMarkQueues[(workerIndex + i) % threadCount]->IsEmpty())
+		{
+			return true;
+		}
+	}
+
+	return false;
 }
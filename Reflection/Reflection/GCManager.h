@@ -1,59 +1,485 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
-#include "FixedVector.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ChunkedVector.h"
+#include "GCFinalizer.h"
+#include "GCHeap.h"
+#include "GCMarkStack.h"
+#include "GCThreadCache.h"
+#include "GCTypeCensus.h"
+#include "GCWorkerPool.h"
+#include "RingBuffer.h"
+#include "WorkStealingQueue.h"
 
 class GCObject;
+class GCRegion;
+class Property;
 
+// CollectIfNeeded 가 수집 시점과 종류를 고르는 기준
+struct GCTriggerPolicy
+{
+	double HeapGrowthFactor = 2.0; // 마지막 전체 수집 후 살아남은 바이트의 이 배수까지 자라면 전체 수집
+	size_t MinHeapTriggerBytes = 4 * 1024 * 1024; // 힙이 작을 때 너무 자주 수집하지 않도록 하는 최소 한도
+	size_t YoungAllocationBudget = 1024 * 1024; // 마지막 수집 후 이만큼 할당하면 마이너 수집, 0 이면 마이너 수집을 하지 않는다
+	int64_t PauseGoalUs = 0; // 예상 전체 수집 정지 시간이 이보다 길면 증분 수집으로 나눈다, 0 이면 목표 없음
+	int64_t IncrementalSliceUs = 1000; // 자동 증분 수집의 슬라이스 하나의 예산
+	double AllocationRatePacing = 1.0; // 증분 수집이 끝나기 전에 한도에 닿을 할당 속도면 미리 시작, 예측 시간의 배수, 0 이면 끈다
+};
+
+struct GCSettings
+{
+	size_t WorkerThreadCount = 0; // 0 이면 hardware_concurrency / 2
+	bool bPinWorkerThreads = false;
+	uint8_t PromotionAge = 2; // 마이너 수집을 이 횟수만큼 살아남으면 올드 세대로 승격
+	bool bLazySweep = true; // 죽은 객체의 소멸을 정지 구간 밖, 이후 할당 시점으로 미룬다
+	size_t MarkStackCapacity = 64 * 1024; // 단일 스레드 마크 스택 크기, 넘치면 마킹된 객체를 다시 훑어 복구
+	size_t MarkPacketSize = 512; // 병렬 마킹에서 이보다 긴 참조 배열은 이 크기의 패킷으로 나눈다, 0 이면 나누지 않음
+	double CompactOccupancyThreshold = 0.5; // 압축 수집에서 사용률이 이보다 낮은 페이지의 객체를 다른 페이지로 옮긴다
+	size_t DebugInfoHistorySize = 64; // 보관할 최근 수집 기록 수
+	bool bTypeCensus = false; // 전체 수집의 스윕에서 타입별 객체 수와 바이트를 모은다
+	bool bCheckRegionEscape = true; // 디버그 빌드에서 GCRegion 이 끝날 때 힙과 루트가 영역 객체를 가리키는지 검사, 힙 전체를 훑는다
+	size_t HeapReserveBytes = sizeof(void*) >= 8 ? 16ull * 1024 * 1024 * 1024 : 256 * 1024 * 1024; // 시작할 때 예약만 해 두는 가상 주소 범위, 페이지는 쓸 때 2MB 단위로 커밋한다, 0 이면 예약하지 않음
+	bool bHugePages = false; // 리눅스에서 예약 범위에 MADV_HUGEPAGE 를 건다, 투명 거대 페이지가 madvise 모드일 때만 효과가 있다
+	GCTriggerPolicy TriggerPolicy;
+};
+
+struct GCWorkerDebugInfo
+{
+	size_t MarkedObjects = 0;
+	size_t StealCount = 0;
+	size_t CreatedPackets = 0;
+	size_t ScannedPackets = 0;
+	size_t SweptObjects = 0;
+	size_t SweptBytes = 0;
+};
+
+enum class GCCollectionMode
+{
+	Full,
+	FullMultiThread,
+	Incremental,
+	Minor,
+	Compact,
+	Concurrent,
+};
+
+// 수집이 시작된 이유
+enum class GCTriggerReason
+{
+	Manual, // Collect* 를 직접 호출
+	HeapGrowth, // 추정 힙 크기가 HeapGrowthFactor 로 정한 한도를 넘었다
+	AllocationRate, // 지금 할당 속도면 증분 수집이 끝나기 전에 한도에 닿는다
+	YoungAllocation, // 마지막 수집 후 할당이 YoungAllocationBudget 을 넘었다
+};
+
+// 수집 한 번의 기록, 정지 구간에서는 숫자만 채우고 문자열은 만들지 않는다
 struct GCDebugInfo
 {
+	GCCollectionMode Mode = GCCollectionMode::Full;
+	GCTriggerReason TriggerReason = GCTriggerReason::Manual;
+	uint64_t CycleIndex = 0; // Create 이후 몇 번째 수집인지, 1부터 시작
+	std::chrono::high_resolution_clock::time_point StartTime;
 	int64_t DurationMs = 0;
-	int64_t DurationUs = 0;
+	int64_t DurationUs = 0; // 정지 시간, 증분 수집에서는 슬라이스 합
+
+	// 단계별 시간, 증분 수집에서는 슬라이스에 걸친 합
+	int64_t RootScanUs = 0;
+	int64_t MarkUs = 0;
+	int64_t SweepUs = 0;
+	int64_t FinalizeUs = 0; // 지연 파이널라이즈 대상을 넘기는 시간
+	int64_t CompactUs = 0;
+	int64_t RemarkUs = 0; // 동시 수집의 마지막 재마킹 정지 시간
+	int64_t ConcurrentMarkUs = 0; // 동시 수집에서 배경 마킹이 끝난 것을 확인하기까지 걸린 시간, 정지가 아니다
+	int64_t TimeToSafepointUs = 0; // 등록된 스레드가 모두 세이프포인트에 설 때까지 기다린 시간, 정지 시간과 별도, 증분 수집에서는 슬라이스 중 최댓값
+	size_t SafepointThreadCount = 0; // 세이프포인트에서 기다린 등록 스레드 수
+
+	size_t AllocatedBytes = 0; // 이전 수집이 끝난 뒤 할당한 슬롯 크기의 합
+	size_t AllocatedObjects = 0;
 	size_t TotalObjects = 0;
 	size_t DeletedObjects = 0;
+	size_t FreedBytes = 0; // 죽은 객체가 차지하던 슬롯 크기의 합, 지연 스윕 대상 포함
+	size_t MaxMarkDepth = 0; // 단일 스레드 마킹에서만 채워진다
 	size_t RemainingObjects = 0;
-	size_t RootObjectCount = 0;
+	size_t RootObjectCount = 0; // GCRoot 로 잡힌 객체 포함
+	size_t StackRootCount = 0; // 스레드의 GCRoot 슬롯에서 읽은 객체 수
+	size_t PendingSweepObjects = 0; // 수집 직후 소멸을 기다리는 죽은 객체 수
+	size_t MarkStackOverflows = 0;
+	size_t MarkPacketSize = 0;
+	size_t MarkPacketCount = 0;
+	size_t DeferredFinalizeObjects = 0; // 파이널라이저 스레드로 넘긴 객체 수
+	size_t ClearedWeakReferences = 0; // 죽은 객체를 가리켜 nullptr 로 바뀐 GCWeakPtr 수
+	size_t CommittedBytes = 0; // 힙이 OS 에서 실제로 받아 둔 바이트, 예약 범위는 청크 단위
+	size_t ReservedBytes = 0;
+	std::vector<GCWorkerDebugInfo> Workers;
+
+	// 압축 수집에서만 채워진다
+	size_t MovedObjects = 0;
+	size_t PinnedObjects = 0;
+	size_t EvacuatedPages = 0;
+	size_t ReleasedPages = 0;
+
+	// 마이너 수집에서는 TotalObjects 가 검사한 영 객체 수
+	size_t PromotedObjects = 0;
+	size_t RememberedSetSize = 0;
+
+	// 증분, 동시 수집에서만 채워지는 슬라이스별 정지 시간
+	size_t SliceCount = 0;
+	int64_t SlicePauseP50Us = 0;
+	int64_t SlicePauseP95Us = 0;
+	int64_t SlicePauseP99Us = 0;
+	int64_t SlicePauseMaxUs = 0;
+	std::vector<int64_t> SlicePausesUs; // 슬라이스 순서대로
+};
+
+enum class GCPhase
+{
+	Idle,
+	Mark,
+	ConcurrentMark,
+	Sweep,
 };
 
 class GCManager final
 {
+	friend class GCObject;
+	friend class GCRegion;
+	template <typename T>
+	friend class GCRoot;
+
 public:
-	static void Create();
+	static void Create(const GCSettings& settings = GCSettings());
 	static GCManager& Get();
 	static void Destroy();
 
 	void Collect();
 	void CollectMultiThread();
+	// 삼색 마킹과 스윕을 budgetUs 만큼씩 진행, 여러 프레임에 걸쳐 호출
+	void CollectIncremental(int64_t budgetUs);
+	// 워커 스레드가 배경에서 마킹하는 동안 변경자는 계속 실행된다, 틱마다 호출
+	// 정지는 루트 스냅샷, 배경 마킹이 끝난 뒤의 재마킹, budgetUs 단위의 증분 스윕 슬라이스뿐
+	// 마킹 중에는 참조 컨테이너에서 원소를 지우거나 비우기 전에도 GC_WRITE_BARRIER(owner, nullptr) 를 호출해야 한다
+	void CollectConcurrent(int64_t budgetUs);
+	// 영 세대만 수집, 증분 수집 중에는 아무 일도 하지 않는다
+	void CollectMinor();
+	// 전체 수집 후 사용률이 낮은 페이지의 객체를 빽빽한 페이지로 옮기고 리플렉션으로 참조를 갱신한다
+	// SetRoot 루트와 Pin 된 객체는 옮기지 않는다, GCRoot 는 새 주소로 바뀌고 네이티브 코드가 들고 있는 다른 GCObject* 는 무효가 된다
+	void CollectCompact();
+
+	// 프레임마다 호출, 정책에 따라 수집 종류를 골라 시작하거나 진행 중인 증분 수집을 이어가고 일을 했으면 true
+	// 네이티브 스택의 GCObject* 는 루트가 아니므로 할당 도중에는 스스로 수집하지 않는다
+	bool CollectIfNeeded();
+	void SetTriggerPolicy(const GCTriggerPolicy& policy);
+	const GCTriggerPolicy& GetTriggerPolicy() const;
+
+	// 지연 스윕 대기 중인 객체를 모두 소멸하고 파이널라이저 스레드도 기다린다
+	// 프레임 사이 등 여유 있는 시점에 호출
+	void FinishSweep();
+
+	// GCObject* 를 객체에 저장하기 직전에 호출
+	static inline void WriteBarrier(GCObject* owner, GCObject* newValue);
 
-	void AddObject(GCObject* object);
+	// 변경자 스레드 외에 GC 객체를 읽고 쓰는 스레드가 호출, 이후 수집은 이 스레드가 세이프포인트에 설 때까지 기다린다
+	// 스레드가 끝나면 자동으로 해제된다
+	void RegisterThread();
+	void UnregisterThread();
+	// 등록한 스레드가 루프마다 호출, 수집 요청이 없으면 relaxed 로드 하나로 끝나고 있으면 수집이 끝날 때까지 멈춘다
+	// 할당은 세이프포인트가 아니다, 넘기지 않은 객체를 들고 있지 않은 지점에서 부른다
+	static inline void Safepoint();
+	// 잠들거나 입출력을 기다리는 등 GC 객체를 건드리지 않는 구간, 수집기는 이 구간의 스레드를 기다리지 않는다
+	// 나올 때 수집 중이면 끝날 때까지 멈춘다
+	void EnterSafeRegion();
+	void LeaveSafeRegion();
+
+	bool IsIncrementalCollecting() const;
+	GCPhase GetIncrementalPhase() const;
+
+	// NewGCObject 에서 사용, 생성자 호출 전의 메모리만 돌려준다
+	// Create 를 호출한 변경자 스레드가 아니면 스레드 지역 할당 버퍼에서 잠금 없이 꺼낸다
+	void* AllocateObject(size_t size);
+	// 생성자가 예외를 던졌을 때 AllocateObject 로 받은 메모리를 돌려준다, 같은 스레드에서 호출
+	void DeallocateObject(void* memory);
+	// bDeferredFinalization 이면 죽은 뒤 파이널라이저 스레드에서 소멸
+	// 다른 스레드에서 만든 객체는 그 스레드의 등록 블록에 쌓였다가 다음 수집 시작(또는 CollectIfNeeded)에서 합쳐진다
+	// 다른 스레드는 자신이 만든 객체끼리만 연결하고, 루트 지정과 기존 객체에 저장은 변경자 스레드에 넘긴 뒤 한다
+	// 네이티브 스택과 마찬가지로 아직 넘기지 않은 객체는 루트가 아니다, RegisterThread 한 스레드는 Safepoint 에서만 멈추므로 그 사이에는 수집과 겹치지 않는다
+	void AddObject(GCObject* object, bool bDeferredFinalization = false);
 	const GCDebugInfo& GetLastDebugInfo() const;
+	// 최근 수집 기록, 0 이 가장 오래된 기록
+	const RingBuffer<GCDebugInfo>& GetDebugInfoHistory() const;
+
+	// 수집이 끝날 때마다 수집을 호출한 스레드에서 불린다, 무거운 작업은 다른 스레드로 넘길 것
+	using DebugInfoListener = std::function<void(const GCDebugInfo&)>;
+	void SetDebugInfoListener(DebugInfoListener listener);
+
+	// 켜져 있으면 전체 수집(단일, 병렬, 증분)의 스윕이 살아있는 객체의 타입도 읽는다
+	void SetTypeCensusEnabled(bool bEnabled);
+	bool IsTypeCensusEnabled() const;
+	// 마지막으로 census 를 모은 전체 수집의 결과
+	const GCTypeCensus& GetTypeCensus() const;
+
+	// 사람이 읽을 수 있는 여러 줄 문자열, 정지 구간 밖에서만 사용
+	static std::string FormatDebugInfo(const GCDebugInfo& info);
+	size_t GetObjectCount() const;
+	size_t GetYoungObjectCount() const;
+	// SetRoot 로 지정한 루트 수, GCRoot 는 포함하지 않는다
+	size_t GetRootObjectCount() const;
+	size_t GetWeakOwnerCount() const;
+	size_t GetPendingSweepCount() const;
+	size_t GetPendingFinalizeCount() const;
+	size_t GetWorkerThreadCount() const;
+	size_t GetHeapPageCount() const;
+	size_t GetRegionPageCount() const;
+	size_t GetCommittedBytes() const;
+	size_t GetReservedBytes() const;
+	// 변경자 외에 동시에 할당한 스레드 수의 최댓값, 끝난 스레드의 캐시는 다른 스레드가 다시 쓴다
+	size_t GetThreadCacheCount() const;
+	size_t GetAllocatedBytesSinceCollection() const;
+	size_t GetAllocatedObjectsSinceCollection() const;
+	// 할당한 바이트에서 수집이 죽었다고 판단한 바이트를 뺀 값, 지연 스윕 대기 객체는 포함하지 않는다
+	size_t GetEstimatedHeapBytes() const;
+	// 추정 힙 크기가 이 값을 넘으면 CollectIfNeeded 가 전체 수집을 시작한다
+	size_t GetHeapTriggerBytes() const;
 
 private:
-	GCManager() = default;
+	GCManager();
 	~GCManager();
 	GCManager(const GCManager&) = delete;
 	GCManager& operator=(const GCManager&) = delete;
 
-	void markFrom(GCObject* root);
 	void markFromRecursive(GCObject* root);
+	// 단일 스레드 전체 수집, 기록은 mLastDebugInfo 에 채우기만 하고 알리지 않는다
+	void collectFull();
+
+	void drainMarkStack();
+	// 마크 스택이 넘쳤던 만큼 마킹된 객체를 다시 훑고, 복구 횟수를 반환
+	size_t recoverMarkStackOverflow();
+
+	// 루트를 워커 큐에 나누어 넣고 마킹, GCRoot 에서 읽은 루트 수를 반환
+	size_t markParallel(size_t threadCount);
+	void markWorker(size_t workerIndex, size_t threadCount);
+	// 마크 작업 단위, 하위 비트가 MARK_WORK_PACKET_TAG 이면 GCMarkPacket*, 아니면 GCObject*
+	using MarkWork = uintptr_t;
+
+	bool stealMarkWork(size_t workerIndex, size_t threadCount, MarkWork& outWork, GCWorkerDebugInfo& workerInfo);
+	bool hasStealableMarkWork(size_t workerIndex, size_t threadCount) const;
+
+	template <typename Func>
+	static void forEachReference(GCObject* object, Func&& func);
+	// 연속 메모리 컨테이너는 슬롯 하나씩이 아니라 (data, count) 로 넘긴다
+	template <typename SlotFunc, typename RangeFunc>
+	static void forEachReferenceRange(GCObject* object, SlotFunc&& slotFunc, RangeFunc&& rangeFunc);
+	// GCWeakPtr 슬롯을 GCObject** 로 넘긴다
+	template <typename Func>
+	static void forEachWeakReference(GCObject* object, Func&& func);
+
+	// 마킹이 끝난 뒤 스윕 전에 호출, 죽을 객체를 가리키는 약한 참조를 비우고 개수를 반환
+	// bMinor 이면 마킹하지 않은 올드 객체는 살아있다고 본다
+	size_t clearWeakReferences(bool bMinor);
+
+	void beginIncrementalCycle();
+	// 마킹이 끝난 뒤 약한 참조를 비우고 스윕 단계로 넘어간다
+	void beginIncrementalSweep();
+	bool incrementalMarkStep(std::chrono::high_resolution_clock::time_point deadline);
+	bool incrementalSweepStep(std::chrono::high_resolution_clock::time_point deadline);
+	void endIncrementalCycle();
+	void abortIncrementalCycle();
+	void shadeObject(GCObject* object);
+
+	void beginConcurrentMark();
+	void concurrentMarkWorker(size_t workerIndex, size_t threadCount);
+	// 배경 마킹이 끝난 뒤 변경자가 남긴 회색 객체를 처리한다
+	void remarkConcurrent();
+	// 아직 검사되지 않은 객체의 참조를 읽어 새로 마킹된 자식을 markChild 로 넘긴다, 이미 검사되었으면 false
+	template <typename Func>
+	bool scanConcurrent(GCObject* object, Func&& markChild);
+	// 참조를 바꾸기 전 owner 의 현재 참조를 스냅샷으로 남기고 newValue 도 회색으로 만든다
+	void concurrentWriteBarrier(GCObject* owner, GCObject* newValue);
+	// 변경자가 남긴 회색 객체를 워커의 큐로 옮긴다
+	bool takeSatbBuffer(WorkStealingQueue<MarkWork>& queue);
+	// 증분 마킹 중 다른 스레드의 쓰기 장벽이 남긴 회색 객체를 회색 목록으로 옮긴다
+	bool takeSatbBuffer(std::vector<GCObject*>& greyObjects);
+
+	void promoteAllYoungObjects();
+	void promoteObject(GCObject* object);
+	bool hasYoungReference(GCObject* object);
+
+	// GCObject::SetRoot 에서 호출
+	void setRoot(GCObject* object, bool bRoot);
+	// 지금 스레드의 GCRoot 스택, 다른 스레드는 RegisterThread 한 뒤에만 쓸 수 있다
+	GCRootStack& getRootStack();
+	// SetRoot 루트와 모든 스레드의 GCRoot 가 가리키는 객체를 넘기고, GCRoot 에서 넘긴 수를 반환
+	// 등록된 스레드가 멈춰 있는 정지 구간에서만 호출
+	template <typename Func>
+	size_t forEachRoot(Func&& func);
+	// nullptr 인 것까지 GCRoot 슬롯 주소를 넘긴다
+	template <typename Func>
+	void forEachStackRootSlot(Func&& func);
+
+	// GCRegion::Promote 에서 호출, 영역 객체를 힙으로 이동 생성해 등록하고 새 주소를 반환
+	GCObject* adoptRegionObject(GCObject* object);
+	// 힙 객체의 참조와 루트 중 region 의 객체를 가리키는 것이 있으면 assert, 쓰레기 객체도 검사에 걸린다
+	void checkRegionEscape(const GCRegion& region);
+
+	// 변경자 스레드면 nullptr, 처음 할당하는 다른 스레드면 캐시를 가져온다
+	GCThreadCache* getThreadCache();
+	// 끝난 스레드의 캐시를 먼저 재사용하고, 없으면 새로 만들어 목록 앞에 CAS 로 잇는다
+	GCThreadCache* acquireThreadCache();
+	// 스레드가 끝날 때 호출, 버퍼의 슬롯을 돌려주고 등록 블록은 다음 병합까지 남긴다
+	void releaseThreadCache(GCThreadCache* cache);
+	// 수집 진입점마다 만들어 등록된 스레드를 세우고 소멸할 때 풀어 준다, 중첩되면 가장 바깥 것만 동작
+	class SafepointScope;
+	// 요청 플래그를 세우고 실행 중인 등록 스레드가 모두 멈출 때까지 기다린다
+	void stopMutatorThreads();
+	void resumeMutatorThreads();
+	// Safepoint 에서 요청을 본 스레드가 수집이 끝날 때까지 기다린다
+	void parkAtSafepoint();
+	// 증분, 동시 수집의 슬라이스 정지 시간과 세이프포인트 대기 시간을 기록
+	void recordSlicePause(int64_t pauseUs);
+
+	// 다른 스레드의 등록 블록에서 아직 옮기지 않은 객체를 영 세대로 옮긴다, 변경자 스레드에서만 호출
+	void mergeThreadObjects();
+	// 등록 목록에 넣고 약한 참조 소유자를 기록
+	void registerObject(GCObject* object);
+
+	// 소멸자 호출 후 슬롯을 힙의 빈 목록으로 반환
+	void destroyObject(GCObject* object);
+	// bLazySweep 이면 크기 클래스별 대기 목록에 넣고, 아니면 바로 소멸
+	void sweepObject(GCObject* object);
+	// 모인 지연 파이널라이즈 대상을 파이널라이저 스레드로 넘기고 개수를 반환
+	size_t flushFinalizeBatch();
+	// 할당할 크기 클래스의 대기 객체부터 count 개 소멸, 없으면 다른 클래스에서 가져온다
+	void sweepPending(size_t sizeClass, size_t count);
+
+	// mLastDebugInfo 에 수집 번호를 붙여 기록하고 리스너에 알린다
+	void publishDebugInfo();
+	// 마지막 전체 수집의 정지 시간을 힙 크기에 비례해 늘린 값
+	int64_t predictFullPauseUs() const;
+	// 지금 할당 속도로 증분 수집 한 번의 시간 동안 할당하면 한도를 넘는지
+	bool isAllocationOutpacing(size_t heapTriggerBytes) const;
+
+	// 이번 압축에서 옮기면 안 되는 객체의 페이지를 고정하고, 고정한 객체 수를 반환
+	size_t pinCompactionTargets();
+
+	static void propertyWriteBarrier(const Property& property, void* object, const void* oldValue, const void* newValue);
 
 private:
+	struct ThreadCacheHandle;
+
 	static GCManager* mInstance;
+	static uint64_t mInstanceCount;
+	static thread_local ThreadCacheHandle mThreadCache;
+	static std::atomic<bool> mbSafepointRequested;
 
 	enum { POOL_SIZE = 1024 * 128 };
+	enum { INCREMENTAL_CHECK_INTERVAL = 64 };
+	enum { LAZY_SWEEP_BATCH = 8 };
+	enum { MARK_PREFETCH_DISTANCE = 8 };
+	enum : uintptr_t { MARK_WORK_PACKET_TAG = 1 };
+	enum { SCAN_LOCK_COUNT = 256 };
+
+	GCSettings mSettings;
+	GCHeap mHeap;
+	uint64_t mInstanceIndex = 0; // 스레드 캐시 핸들이 이전 인스턴스의 캐시를 쓰지 않도록 구분
+	std::atomic<GCThreadCache*> mThreadCaches = nullptr;
+	size_t mSafepointDepth = 0;
+	int64_t mTimeToSafepointUs = 0; // 마지막으로 세운 정지의 대기 시간
+	size_t mSafepointThreadCount = 0;
+
+	ChunkedVector<GCObject*> mGCObjects; // 올드 세대
+	ChunkedVector<GCObject*> mYoungObjects;
+	std::vector<GCObject*> mRootObjects;
+	GCRootStack mRootStack; // 변경자 스레드의 GCRoot, 다른 스레드는 GCThreadCache 에 있다
+	std::vector<GCObject*> mWeakOwners; // GCWeakPtr 프로퍼티가 있는 객체
+	std::vector<GCObject*> mRememberedSet;
+	std::vector<GCObject*> mMinorMarkStack;
+
+	std::array<std::vector<GCObject*>, GCHeap::SIZE_CLASS_COUNT + 1> mPendingSweep;
+	size_t mPendingSweepCount = 0;
+
+	std::vector<GCObject*> mFinalizeBatch;
+	std::unique_ptr<GCFinalizer> mFinalizer;
 
-	FixedVector<GCObject*, POOL_SIZE> mGCObjects;
 	GCDebugInfo mLastDebugInfo;
+	RingBuffer<GCDebugInfo> mDebugInfoHistory;
+	DebugInfoListener mDebugInfoListener;
+	uint64_t mCollectionCount = 0;
+	GCTypeCensus mTypeCensus;
+	std::vector<GCTypeCensus> mWorkerTypeCensus;
+
+	// 수집 정책, 변경자 스레드에서만 갱신
+	GCTriggerReason mTriggerReason = GCTriggerReason::Manual;
+	size_t mAllocatedBytes = 0; // 마지막 수집 이후
+	size_t mAllocatedObjects = 0;
+	size_t mHeapBytes = 0;
+	size_t mHeapBytesAfterFull = 0;
+	int64_t mFullPauseUs = 0;
+	size_t mFullPauseHeapBytes = 0; // 그 정지 시간을 잴 때의 힙 크기
+	int64_t mIncrementalCycleUs = 0; // 마지막 증분 수집의 시작부터 끝까지 걸린 시간
+	std::chrono::high_resolution_clock::time_point mLastCollectionEndTime = std::chrono::high_resolution_clock::now();
+
 	std::atomic<size_t> mMaxDepth;
+	GCMarkStack mMarkStack;
+
+	std::unique_ptr<GCWorkerPool> mWorkerPool;
+	std::vector<std::unique_ptr<WorkStealingQueue<MarkWork>>> mMarkQueues;
+	std::vector<std::deque<GCMarkPacket>> mMarkPackets; // 워커별, 사이클 동안 주소가 유지되어야 한다
+	std::atomic<size_t> mIdleMarkWorkerCount = 0;
+
+	std::atomic<GCPhase> mIncrementalPhase = GCPhase::Idle; // 다른 스레드가 할당할 때 읽는다
+	std::atomic<bool> mbWriteBarrierActive = false;
+	std::vector<GCObject*> mGreyObjects;
+	size_t mSweepCursor = 0;
+	GCDebugInfo mIncrementalDebugInfo;
+	std::vector<int64_t> mSlicePausesUs;
 
-	std::vector<GCObject*> mTempCacheObject;
+	// 동시 마킹, 객체 검사는 주소로 고른 스핀 락 아래에서 한 번만 일어난다
+	std::array<GCSpinLock, SCAN_LOCK_COUNT> mScanLocks;
+	GCSpinLock mSatbLock;
+	std::vector<GCObject*> mSatbBuffer;
+	std::atomic<bool> mbSatbPending = false;
+	std::atomic<bool> mbConcurrentMarkAbort = false;
 };
 
-inline void GCManager::Create()
+inline void GCManager::Create(const GCSettings& settings)
 {
 	mInstance = new GCManager();
-	mInstance->mTempCacheObject.reserve(POOL_SIZE);
+	mInstance->mSettings = settings;
+	mInstance->mMarkStack.Reserve(settings.MarkStackCapacity);
+	mInstance->mDebugInfoHistory.Resize(settings.DebugInfoHistorySize);
+
+	// 예약에 실패하면 페이지마다 aligned_alloc 으로 받는다
+	if (settings.HeapReserveBytes > 0)
+	{
+		mInstance->mHeap.Reserve(settings.HeapReserveBytes, settings.bHugePages);
+	}
+
+	size_t threadCount = settings.WorkerThreadCount;
+
+	if (threadCount == 0)
+	{
+		threadCount = std::max<size_t>(1, std::thread::hardware_concurrency() / 2);
+	}
+
+	mInstance->mWorkerPool = std::make_unique<GCWorkerPool>(threadCount, settings.bPinWorkerThreads);
+}
+
+inline void GCManager::Safepoint()
+{
+	if (mbSafepointRequested.load(std::memory_order_relaxed))
+	{
+		mInstance->parkAtSafepoint();
+	}
 }
 
 inline GCManager& GCManager::Get()
@@ -68,12 +494,140 @@ inline void GCManager::Destroy()
 	mInstance = nullptr;
 }
 
-inline void GCManager::AddObject(GCObject* object)
+inline bool GCManager::IsIncrementalCollecting() const
+{
+	return mIncrementalPhase != GCPhase::Idle;
+}
+
+inline GCPhase GCManager::GetIncrementalPhase() const
 {
-	mGCObjects.Add(object);
+	return mIncrementalPhase;
 }
 
 inline const GCDebugInfo& GCManager::GetLastDebugInfo() const
 {
 	return mLastDebugInfo;
+}
+
+inline const RingBuffer<GCDebugInfo>& GCManager::GetDebugInfoHistory() const
+{
+	return mDebugInfoHistory;
+}
+
+inline void GCManager::SetDebugInfoListener(DebugInfoListener listener)
+{
+	mDebugInfoListener = std::move(listener);
+}
+
+inline void GCManager::SetTypeCensusEnabled(bool bEnabled)
+{
+	mSettings.bTypeCensus = bEnabled;
+}
+
+inline bool GCManager::IsTypeCensusEnabled() const
+{
+	return mSettings.bTypeCensus;
+}
+
+inline const GCTypeCensus& GCManager::GetTypeCensus() const
+{
+	return mTypeCensus;
+}
+
+inline void GCManager::SetTriggerPolicy(const GCTriggerPolicy& policy)
+{
+	mSettings.TriggerPolicy = policy;
+}
+
+inline const GCTriggerPolicy& GCManager::GetTriggerPolicy() const
+{
+	return mSettings.TriggerPolicy;
+}
+
+inline size_t GCManager::GetAllocatedBytesSinceCollection() const
+{
+	return mAllocatedBytes;
+}
+
+inline size_t GCManager::GetAllocatedObjectsSinceCollection() const
+{
+	return mAllocatedObjects;
+}
+
+inline size_t GCManager::GetEstimatedHeapBytes() const
+{
+	return mHeapBytes;
+}
+
+inline size_t GCManager::GetHeapTriggerBytes() const
+{
+	const GCTriggerPolicy& policy = mSettings.TriggerPolicy;
+	return std::max(policy.MinHeapTriggerBytes, static_cast<size_t>(mHeapBytesAfterFull * policy.HeapGrowthFactor));
+}
+
+inline size_t GCManager::GetObjectCount() const
+{
+	return mGCObjects.GetSize() + mYoungObjects.GetSize();
+}
+
+inline size_t GCManager::GetYoungObjectCount() const
+{
+	return mYoungObjects.GetSize();
+}
+
+inline size_t GCManager::GetRootObjectCount() const
+{
+	return mRootObjects.size();
+}
+
+inline size_t GCManager::GetWeakOwnerCount() const
+{
+	return mWeakOwners.size();
+}
+
+inline size_t GCManager::GetPendingSweepCount() const
+{
+	return mPendingSweepCount;
+}
+
+inline size_t GCManager::GetPendingFinalizeCount() const
+{
+	return mFinalizer->GetPendingCount();
+}
+
+inline size_t GCManager::GetWorkerThreadCount() const
+{
+	return mWorkerPool->GetThreadCount();
+}
+
+inline size_t GCManager::GetHeapPageCount() const
+{
+	return mHeap.GetPageCount();
+}
+
+inline size_t GCManager::GetRegionPageCount() const
+{
+	return mHeap.GetRegionPageCount();
+}
+
+inline size_t GCManager::GetCommittedBytes() const
+{
+	return mHeap.GetCommittedBytes();
+}
+
+inline size_t GCManager::GetReservedBytes() const
+{
+	return mHeap.GetReservedBytes();
+}
+
+inline size_t GCManager::GetThreadCacheCount() const
+{
+	size_t count = 0;
+
+	for (GCThreadCache* cache = mThreadCaches.load(std::memory_order_acquire); cache != nullptr; cache = cache->Next)
+	{
+		++count;
+	}
+
+	return count;
 }
\ No newline at end of file
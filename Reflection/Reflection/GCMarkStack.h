@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define GC_PREFETCH(Address) _mm_prefetch(reinterpret_cast<const char*>(Address), _MM_HINT_T0)
+#elif defined(__GNUC__) || defined(__clang__)
+#define GC_PREFETCH(Address) __builtin_prefetch(Address)
+#else
+#define GC_PREFETCH(Address) ((void)(Address))
+#endif
+
+class GCObject;
+
+// 수집 사이클과 루트에 걸쳐 재사용하는 고정 크기 마크 스택
+// 가득 차면 Push 가 실패하고 넘침 표시만 남긴다, 호출자는 마킹된 객체를 다시 훑어 복구
+class GCMarkStack final
+{
+public:
+	struct Entry
+	{
+		GCObject* Object = nullptr;
+		size_t Depth = 0;
+	};
+
+	GCMarkStack() = default;
+	GCMarkStack(const GCMarkStack&) = delete;
+	GCMarkStack& operator=(const GCMarkStack&) = delete;
+
+	void Reserve(size_t capacity)
+	{
+		assert(mSize == 0);
+		mEntries = std::make_unique<Entry[]>(capacity);
+		mCapacity = capacity;
+	}
+
+	bool Push(GCObject* object, size_t depth)
+	{
+		if (mSize == mCapacity)
+		{
+			mbOverflowed = true;
+			return false;
+		}
+
+		mEntries[mSize++] = Entry{ object, depth };
+		return true;
+	}
+
+	bool Pop(Entry& outEntry)
+	{
+		if (mSize == 0)
+		{
+			return false;
+		}
+
+		outEntry = mEntries[--mSize];
+		return true;
+	}
+
+	bool IsEmpty() const { return mSize == 0; }
+	size_t GetCapacity() const { return mCapacity; }
+
+	bool HasOverflowed() const { return mbOverflowed; }
+	void ClearOverflow() { mbOverflowed = false; }
+
+private:
+	std::unique_ptr<Entry[]> mEntries;
+	size_t mCapacity = 0;
+	size_t mSize = 0;
+	bool mbOverflowed = false;
+};
+
+// 큰 참조 배열의 일부 구간, 병렬 마킹에서 다른 워커가 훔쳐 갈 수 있는 단위
+struct GCMarkPacket
+{
+	GCObject** Begin = nullptr;
+	size_t Count = 0;
+};
+
+// 스택에서 꺼낸 객체를 바로 검사하지 않고 Distance 단계 뒤에 검사하는 작은 FIFO
+// 들어올 때 프리페치해 두면 검사할 때쯤 헤더가 캐시에 올라와 있다
+template <typename T, size_t Distance>
+class GCPrefetchQueue final
+{
+	static_assert((Distance & (Distance - 1)) == 0, "Distance must be a power of two");
+
+public:
+	// 가득 차 있으면 가장 오래된 값을 outEvicted 로 내보내고 true
+	bool Push(const T& value, T& outEvicted)
+	{
+		bool bEvicted = false;
+
+		if (mSize == Distance)
+		{
+			outEvicted = mItems[mHead];
+			mHead = (mHead + 1) & (Distance - 1);
+			--mSize;
+			bEvicted = true;
+		}
+
+		mItems[(mHead + mSize) & (Distance - 1)] = value;
+		++mSize;
+
+		return bEvicted;
+	}
+
+	bool Pop(T& outValue)
+	{
+		if (mSize == 0)
+		{
+			return false;
+		}
+
+		outValue = mItems[mHead];
+		mHead = (mHead + 1) & (Distance - 1);
+		--mSize;
+
+		return true;
+	}
+
+	bool IsEmpty() const { return mSize == 0; }
+
+private:
+	std::array<T, Distance> mItems = {};
+	size_t mHead = 0;
+	size_t mSize = 0;
+};
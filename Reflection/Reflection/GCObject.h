@@ -1,16 +1,25 @@
 #pragma once
 
 #include <atomic>
+#include <cassert>
+#include <cstdint>
 
 #include "Property.h"
+#include "GCManager.h"
 
-class GCManager;
+// 소멸자가 무거운(버퍼 해제, 핸들 닫기 등) 타입의 클래스 선언 안에 넣으면
+// 죽은 뒤 GC 정지 구간이 아닌 파이널라이저 스레드에서 소멸된다
+#define GC_DEFERRED_FINALIZATION \
+public: \
+	static constexpr bool bDeferredFinalization = true; \
+private:
 
 class GCObject
 {
 	GENERATE_TYPE_INFO(GCObject)
 
 	friend class GCManager;
+	friend class GCRegion;
 
 public:
 	GCObject() = default;
@@ -19,19 +28,93 @@ public:
 	GCObject& operator=(const GCObject&) = default;
 
 	bool IsRoot() const { return mbRoot; }
-	void SetRoot(bool v) { mbRoot = v; }
+	inline void SetRoot(bool v);
+
+	bool IsOld() const { return mbOld; }
+
+	// 네이티브 코드가 주소를 들고 있는 동안 압축 수집에서 옮겨지지 않도록 고정, 중첩 가능
+	void Pin() { ++mPinCount; }
+	inline void Unpin();
+	bool IsPinned() const { return mPinCount > 0; }
 
 private:
-	bool atomicMark()
+	// 마크 비트는 객체가 아닌 GCHeap 페이지의 비트맵에 있다
+	bool atomicMark() { return GCHeap::Mark(this); }
+	bool isMarked() const { return GCHeap::IsMarked(this); }
+	void setMarked(bool v)
 	{
-		bool expected = false;
-		return mbMark.compare_exchange_strong(expected, true);
+		if (v)
+		{
+			GCHeap::Mark(this);
+		}
+		else
+		{
+			GCHeap::ClearMark(this);
+		}
 	}
 
-	bool isMarked() const { return mbMark.load(std::memory_order_relaxed); }
-	void setMarked(bool v) { mbMark.store(v, std::memory_order_relaxed); }
-
 private:
-	std::atomic<bool> mbMark = false;
 	bool mbRoot = false;
-};
\ No newline at end of file
+	bool mbDeferredFinalization = false;
+
+	// 세대 정보
+	bool mbOld = false;
+	bool mbRemembered = false;
+	uint8_t mAge = 0;
+
+	uint16_t mPinCount = 0;
+};
+
+inline void GCObject::Unpin()
+{
+	assert(mPinCount > 0);
+	--mPinCount;
+}
+
+inline void GCObject::SetRoot(bool v)
+{
+	if (mbRoot == v)
+	{
+		return;
+	}
+
+	mbRoot = v;
+	GCManager::Get().setRoot(this, v);
+
+	// 증분 마킹 도중 루트가 된 객체도 이번 사이클에서 살아남아야 한다
+	if (v)
+	{
+		GCManager::WriteBarrier(nullptr, this);
+	}
+}
+
+// GCManager.h 에서는 GCObject 가 불완전 타입이라 여기서 정의
+inline void GCManager::WriteBarrier(GCObject* owner, GCObject* newValue)
+{
+	if (mInstance->mbWriteBarrierActive.load(std::memory_order_relaxed))
+	{
+		// 동시 마킹 중에는 지워질 참조까지 남겨야 하므로 nullptr 저장도 처리한다
+		if (mInstance->mIncrementalPhase == GCPhase::ConcurrentMark)
+		{
+			mInstance->concurrentWriteBarrier(owner, newValue);
+		}
+		// 증분 마킹 중에는 새로 연결되는 객체를 회색으로 만들어 검은 객체가 흰 객체를 가리키지 않도록 한다
+		// 영역 객체는 따라가지 않으므로 회색 목록에 남기지 않는다
+		else if (newValue != nullptr && !GCHeap::IsRegion(newValue))
+		{
+			mInstance->shadeObject(newValue);
+		}
+	}
+
+	if (newValue == nullptr)
+	{
+		return;
+	}
+
+	// 올드 -> 영 참조는 마이너 수집의 루트가 되므로 기억 집합에 기록
+	if (owner != nullptr && owner->mbOld && !newValue->mbOld && !owner->mbRemembered)
+	{
+		owner->mbRemembered = true;
+		mInstance->mRememberedSet.push_back(owner);
+	}
+}
\ No newline at end of file
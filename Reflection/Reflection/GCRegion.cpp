@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cassert>
+
+#include "GCRegion.h"
+
+GCRegion::GCRegion(GCManager& gcManager)
+	: mGCManager(gcManager)
+{
+}
+
+GCRegion::~GCRegion()
+{
+	Reset();
+
+	if (mPages != nullptr)
+	{
+		mGCManager.mHeap.ReleaseRegionPage(mPages);
+	}
+}
+
+void* GCRegion::allocateSlow(size_t size)
+{
+	GCPage* page = mGCManager.mHeap.AcquireRegionPage(size);
+	page->NextPage = mPages;
+	mPages = page;
+	mAllocatedBytes += size;
+
+	// 한 페이지를 넘는 객체는 전용 블록에 두고, 이어지는 할당은 원래 페이지에서 계속한다
+	if (page->BlockSize != GCHeap::PAGE_SIZE)
+	{
+		return page->SlotBegin;
+	}
+
+	mCursor = page->SlotBegin + size;
+	mEnd = reinterpret_cast<char*>(page) + GCHeap::PAGE_SIZE;
+
+	return page->SlotBegin;
+}
+
+GCObject* GCRegion::promote(GCObject* object)
+{
+	// 보통 방금 만든 객체를 옮기므로 뒤에서부터 찾는다
+	auto iter = std::find(mObjects.rbegin(), mObjects.rend(), object);
+	assert(iter != mObjects.rend() && "GCRegion::Promote requires an object created in this region");
+
+	*iter = nullptr;
+	--mObjectCount;
+
+	return mGCManager.adoptRegionObject(object);
+}
+
+void GCRegion::Reset()
+{
+#ifndef NDEBUG
+	if (mObjectCount > 0)
+	{
+		mGCManager.checkRegionEscape(*this);
+	}
+#endif
+
+	for (auto iter = mObjects.rbegin(); iter != mObjects.rend(); ++iter)
+	{
+		if (*iter != nullptr)
+		{
+			(*iter)->~GCObject();
+		}
+	}
+
+	mObjects.clear();
+	mObjectCount = 0;
+	mAllocatedBytes = 0;
+
+	// 가장 최근에 쓴 한 페이지짜리 하나만 남겨 다음 프레임이 힙을 거치지 않고 바로 밀어 넣게 한다
+	GCPage* keptPage = nullptr;
+	GCPage* page = mPages;
+
+	while (page != nullptr)
+	{
+		GCPage* next = page->NextPage;
+
+		if (keptPage == nullptr && page->BlockSize == GCHeap::PAGE_SIZE)
+		{
+			keptPage = page;
+		}
+		else
+		{
+			mGCManager.mHeap.ReleaseRegionPage(page);
+		}
+
+		page = next;
+	}
+
+	mPages = keptPage;
+	mCursor = nullptr;
+	mEnd = nullptr;
+
+	if (keptPage != nullptr)
+	{
+		keptPage->NextPage = nullptr;
+		mCursor = keptPage->SlotBegin;
+		mEnd = reinterpret_cast<char*>(keptPage) + GCHeap::PAGE_SIZE;
+	}
+}
+
+bool GCRegion::Contains(const void* ptr) const
+{
+	if (!GCHeap::IsRegion(ptr))
+	{
+		return false;
+	}
+
+	const GCPage* objectPage = GCHeap::GetPage(ptr);
+
+	for (const GCPage* page = mPages; page != nullptr; page = page->NextPage)
+	{
+		if (page == objectPage)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
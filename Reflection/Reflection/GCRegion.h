@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "GCObject.h"
+#include "GCUtility.h"
+
+// 한 프레임 안에서 만들고 버리는 GCObject 를 위한 영역, 스코프가 끝나면 추적 없이 한꺼번에 소멸한다
+// NewGCObject(region, ...) 로 만든 객체는 등록되지 않고 루트도 아니며 수집기가 따라가지 않는다
+// 영역 객체가 가리키는 힙 객체는 다른 경로로 살아 있어야 하고, 힙 객체와 루트, GCWeakPtr 는 영역 객체를 가리키면 안 된다
+// 디버그 빌드에서는 변경자 스레드의 영역이 끝날 때 힙과 루트를 훑어 확인한다 (GCSettings::bCheckRegionEscape)
+// 남겨야 할 객체는 Promote 로 힙에 옮긴다, 만든 스레드에서만 사용
+class GCRegion final
+{
+public:
+	explicit GCRegion(GCManager& gcManager);
+	~GCRegion();
+	GCRegion(const GCRegion&) = delete;
+	GCRegion& operator=(const GCRegion&) = delete;
+
+	// NewGCObject 에서 사용, 생성자 호출 전의 메모리를 현재 페이지에서 밀어 내며 잘라 준다
+	inline void* Allocate(size_t size);
+	inline void AddObject(GCObject* object, bool bDeferredFinalization);
+
+	// 이동 생성으로 힙에 옮기고 새 주소를 반환, 다른 영역 객체가 들고 있던 옛 주소는 바뀌지 않는다
+	template <typename T>
+	T* Promote(T* object);
+
+	// 객체를 만든 역순으로 한 번에 소멸하고 남긴 페이지 하나의 처음으로 되돌린다, 나머지 페이지는 힙에 돌려준다
+	void Reset();
+
+	bool Contains(const void* ptr) const;
+	size_t GetObjectCount() const;
+	size_t GetAllocatedBytes() const;
+
+private:
+	void* allocateSlow(size_t size);
+	GCObject* promote(GCObject* object);
+
+private:
+	GCManager& mGCManager;
+	GCPage* mPages = nullptr; // 가장 최근 페이지, NextPage 로 이전 페이지가 이어진다
+	char* mCursor = nullptr;
+	char* mEnd = nullptr;
+	std::vector<GCObject*> mObjects; // 만든 순서, 힙으로 옮긴 객체는 nullptr
+	size_t mObjectCount = 0;
+	size_t mAllocatedBytes = 0;
+};
+
+template <typename T, typename... Args>
+T* NewGCObject(GCRegion& region, Args&&... args)
+{
+	static_assert(std::is_base_of_v<GCObject, T>, "NewGCObject requires T to be derived from GCObject");
+
+	static_assert(alignof(T) <= GCHeap::SLOT_ALIGNMENT, "NewGCObject requires alignment not greater than GCHeap::SLOT_ALIGNMENT");
+
+	void* memory = region.Allocate(sizeof(T));
+	T* object = new (memory) T(std::forward<Args>(args)...);
+	region.AddObject(object, DeferredFinalization<T>);
+
+	return object;
+}
+
+inline void* GCRegion::Allocate(size_t size)
+{
+	const size_t alignedSize = (size + GCHeap::SLOT_ALIGNMENT - 1) & ~static_cast<size_t>(GCHeap::SLOT_ALIGNMENT - 1);
+
+	if (static_cast<size_t>(mEnd - mCursor) < alignedSize)
+	{
+		return allocateSlow(alignedSize);
+	}
+
+	void* memory = mCursor;
+	mCursor += alignedSize;
+	mAllocatedBytes += alignedSize;
+
+	return memory;
+}
+
+inline void GCRegion::AddObject(GCObject* object, bool bDeferredFinalization)
+{
+	// 영역 객체는 Reset 에서 바로 소멸하므로 파이널라이저 스레드로 넘기지 않는다, Promote 할 때 쓰기 위해 남겨 둔다
+	object->mbDeferredFinalization = bDeferredFinalization;
+	mObjects.push_back(object);
+	++mObjectCount;
+}
+
+template <typename T>
+T* GCRegion::Promote(T* object)
+{
+	static_assert(std::is_base_of_v<GCObject, T>, "GCRegion::Promote requires T to be derived from GCObject");
+
+	return static_cast<T*>(promote(object));
+}
+
+inline size_t GCRegion::GetObjectCount() const
+{
+	return mObjectCount;
+}
+
+inline size_t GCRegion::GetAllocatedBytes() const
+{
+	return mAllocatedBytes;
+}
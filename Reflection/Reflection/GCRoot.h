@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cassert>
+#include <type_traits>
+
+#include "GCObject.h"
+
+// 네이티브 스택에서만 쓰는 임시 객체를 스코프 동안 살려 두는 루트 핸들
+// 객체의 루트 플래그를 건드리지 않고 스레드의 그림자 스택에 슬롯 주소만 쌓는다, 수집기는 그 슬롯을 직접 읽는다
+// 생성한 역순으로 소멸해야 하며 복사, 이동할 수 없다
+// 변경자 스레드나 RegisterThread 한 스레드에서만 사용, 압축 수집에서 대상이 옮겨지면 슬롯도 새 주소로 바뀐다
+// GCRegion 의 객체는 잡을 수 없다
+template <typename T>
+class GCRoot final
+{
+public:
+	explicit GCRoot(T* object = nullptr)
+		: mStack(GCManager::Get().getRootStack())
+		, mObject(object)
+	{
+		static_assert(std::is_base_of_v<GCObject, T>, "GCRoot requires T to be derived from GCObject");
+		assert(object == nullptr || !GCHeap::IsRegion(object));
+
+		mStack.Push(&mObject);
+
+		// 증분 마킹 도중 루트가 된 객체도 이번 사이클에서 살아남아야 한다
+		if (object != nullptr)
+		{
+			GCManager::WriteBarrier(nullptr, object);
+		}
+	}
+
+	~GCRoot()
+	{
+		mStack.Pop(&mObject);
+	}
+
+	GCRoot(const GCRoot&) = delete;
+	GCRoot& operator=(const GCRoot&) = delete;
+
+	GCRoot& operator=(T* object)
+	{
+		assert(object == nullptr || !GCHeap::IsRegion(object));
+
+		if (object != nullptr)
+		{
+			GCManager::WriteBarrier(nullptr, object);
+		}
+
+		mObject = object;
+		return *this;
+	}
+
+	T* Get() const { return static_cast<T*>(mObject); }
+	T* operator->() const { return Get(); }
+	T& operator*() const { return *Get(); }
+	explicit operator bool() const { return mObject != nullptr; }
+
+private:
+	GCRootStack& mStack;
+	// 수집기는 이 필드를 GCObject* 슬롯으로 보고 읽거나 옮긴다
+	GCObject* mObject;
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "GCHeap.h"
+
+class GCObject;
+
+// 세이프포인트에서 본 스레드 상태
+enum class GCThreadState : uint8_t
+{
+	Detached, // RegisterThread 전이나 UnregisterThread 후, 수집기가 기다리지 않는다
+	Running,
+	Parked, // 세이프포인트에서 수집이 끝나기를 기다린다
+	SafeRegion, // GC 객체를 건드리지 않는 구간, 수집기가 기다리지 않는다
+};
+
+// GCRoot 가 자기 슬롯의 주소를 쌓는 스레드별 그림자 스택, 생성과 소멸이 스코프를 따르므로 쌓은 역순으로 뺀다
+// 소유 스레드만 바꾸고, 수집기는 그 스레드가 멈춰 있거나 안전 구간에 있을 때만 읽는다
+struct GCRootStack
+{
+	void Push(GCObject** slot) { Slots.push_back(slot); }
+	void Pop([[maybe_unused]] GCObject** slot)
+	{
+		assert(!Slots.empty() && Slots.back() == slot && "GCRoot must be destroyed in reverse order of construction");
+		Slots.pop_back();
+	}
+
+	std::vector<GCObject**> Slots;
+};
+
+// 변경자가 아닌 스레드가 만든 객체를 모아 두는 블록
+// 소유 스레드만 쓰고, 수집기는 Count 까지만 읽어 등록 목록으로 옮긴다
+struct GCRegistrationBlock
+{
+	enum { CAPACITY = 256 };
+
+	std::array<GCObject*, CAPACITY> Objects;
+	std::atomic<uint32_t> Count = 0;
+	uint32_t MergedCount = 0; // 수집기만 사용
+	GCRegistrationBlock* Next = nullptr; // 먼저 가득 찬 블록
+};
+
+// 스레드마다 하나인 할당 버퍼와 등록 블록 목록, 루트 스택
+// GCManager 가 목록으로 들고 있다가 스레드가 끝나면 다른 스레드가 다시 가져가 쓰고, Destroy 에서 해제한다
+struct GCThreadCache
+{
+	GCThreadCache() = default;
+	inline ~GCThreadCache();
+	GCThreadCache(const GCThreadCache&) = delete;
+	GCThreadCache& operator=(const GCThreadCache&) = delete;
+
+	// 잠그지 않고 현재 블록 끝에 추가, 가득 차면 새 블록을 앞에 잇는다
+	inline void Register(GCObject* object);
+
+	GCAllocationBuffer AllocationBuffer;
+	std::atomic<GCRegistrationBlock*> Blocks = nullptr; // 가장 최근 블록, 소유 스레드만 바꾼다
+	GCRootStack RootStack;
+	std::atomic<bool> bInUse = true;
+	std::atomic<GCThreadState> State = GCThreadState::Detached;
+	GCThreadCache* Next = nullptr; // GCManager 의 캐시 목록, 연결된 뒤에는 바뀌지 않는다
+};
+
+inline GCThreadCache::~GCThreadCache()
+{
+	GCRegistrationBlock* block = Blocks.load(std::memory_order_relaxed);
+
+	while (block != nullptr)
+	{
+		GCRegistrationBlock* next = block->Next;
+		delete block;
+		block = next;
+	}
+}
+
+inline void GCThreadCache::Register(GCObject* object)
+{
+	GCRegistrationBlock* block = Blocks.load(std::memory_order_relaxed);
+	uint32_t count = block != nullptr ? block->Count.load(std::memory_order_relaxed) : static_cast<uint32_t>(GCRegistrationBlock::CAPACITY);
+
+	// 앞선 블록의 Next 는 수집기가 바꿀 수 있으므로 새 블록을 만들 때 말고는 건드리지 않는다
+	if (count == GCRegistrationBlock::CAPACITY)
+	{
+		GCRegistrationBlock* newBlock = new GCRegistrationBlock();
+		newBlock->Next = block;
+		Blocks.store(newBlock, std::memory_order_release);
+
+		block = newBlock;
+		count = 0;
+	}
+
+	block->Objects[count] = object;
+	block->Count.store(count + 1, std::memory_order_release);
+}
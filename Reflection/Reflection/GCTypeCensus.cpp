@@ -0,0 +1,80 @@
+#include <algorithm>
+
+#include "GCTypeCensus.h"
+
+void GCTypeCensus::Reset()
+{
+	for (GCTypeCensusEntry& entry : mEntries)
+	{
+		entry = GCTypeCensusEntry{ entry.Type };
+	}
+}
+
+void GCTypeCensus::Merge(const GCTypeCensus& other)
+{
+	if (mEntries.size() < other.mEntries.size())
+	{
+		mEntries.resize(other.mEntries.size());
+	}
+
+	for (size_t typeId = 0; typeId < other.mEntries.size(); ++typeId)
+	{
+		const GCTypeCensusEntry& source = other.mEntries[typeId];
+		GCTypeCensusEntry& entry = mEntries[typeId];
+
+		if (source.Type != nullptr)
+		{
+			entry.Type = source.Type;
+		}
+
+		entry.LiveObjects += source.LiveObjects;
+		entry.LiveBytes += source.LiveBytes;
+		entry.FreedObjects += source.FreedObjects;
+		entry.FreedBytes += source.FreedBytes;
+	}
+}
+
+std::vector<GCTypeCensusEntry> GCTypeCensus::GetEntries() const
+{
+	std::vector<GCTypeCensusEntry> entries;
+
+	for (const GCTypeCensusEntry& entry : mEntries)
+	{
+		if (entry.LiveObjects > 0 || entry.FreedObjects > 0)
+		{
+			entries.push_back(entry);
+		}
+	}
+
+	std::sort(entries.begin(), entries.end(), [](const GCTypeCensusEntry& lhs, const GCTypeCensusEntry& rhs) {
+		return lhs.LiveBytes > rhs.LiveBytes;
+		});
+
+	return entries;
+}
+
+const GCTypeCensusEntry* GCTypeCensus::Find(const TypeInfo& type) const
+{
+	const size_t typeId = type.GetTypeId();
+
+	if (typeId >= mEntries.size() || mEntries[typeId].Type == nullptr)
+	{
+		return nullptr;
+	}
+
+	return &mEntries[typeId];
+}
+
+void GCTypeCensus::WriteCsv(std::ostream& os) const
+{
+	os << "Type,LiveObjects,LiveBytes,FreedObjects,FreedBytes\n";
+
+	for (const GCTypeCensusEntry& entry : GetEntries())
+	{
+		os << '"' << entry.Type->GetName() << "\","
+			<< entry.LiveObjects << ','
+			<< entry.LiveBytes << ','
+			<< entry.FreedObjects << ','
+			<< entry.FreedBytes << '\n';
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+#include "TypeInfo.h"
+
+struct GCTypeCensusEntry
+{
+	const TypeInfo* Type = nullptr;
+	size_t LiveObjects = 0;
+	size_t LiveBytes = 0; // 슬롯 크기 기준
+	size_t FreedObjects = 0;
+	size_t FreedBytes = 0;
+};
+
+// 스윕에서 모으는 타입별 살아있는/해제된 객체 수와 바이트
+// TypeInfo::GetTypeId 로 인덱싱하는 배열이라 객체마다 해시 조회가 없다, 스레드마다 하나씩 두고 Merge 로 합친다
+class GCTypeCensus final
+{
+public:
+	// 카운터만 비우고 배열 크기는 유지
+	void Reset();
+
+	inline void AddLive(const TypeInfo& type, size_t bytes);
+	inline void AddFreed(const TypeInfo& type, size_t bytes);
+
+	void Merge(const GCTypeCensus& other);
+
+	// 한 번이라도 집계된 타입만, 살아있는 바이트가 많은 순
+	std::vector<GCTypeCensusEntry> GetEntries() const;
+	// 집계된 적 없으면 nullptr
+	const GCTypeCensusEntry* Find(const TypeInfo& type) const;
+
+	// Type,LiveObjects,LiveBytes,FreedObjects,FreedBytes
+	void WriteCsv(std::ostream& os) const;
+
+private:
+	inline GCTypeCensusEntry& entryAt(const TypeInfo& type);
+
+private:
+	std::vector<GCTypeCensusEntry> mEntries;
+};
+
+inline void GCTypeCensus::AddLive(const TypeInfo& type, size_t bytes)
+{
+	GCTypeCensusEntry& entry = entryAt(type);
+	++entry.LiveObjects;
+	entry.LiveBytes += bytes;
+}
+
+inline void GCTypeCensus::AddFreed(const TypeInfo& type, size_t bytes)
+{
+	GCTypeCensusEntry& entry = entryAt(type);
+	++entry.FreedObjects;
+	entry.FreedBytes += bytes;
+}
+
+inline GCTypeCensusEntry& GCTypeCensus::entryAt(const TypeInfo& type)
+{
+	const size_t typeId = type.GetTypeId();
+
+	if (typeId >= mEntries.size())
+	{
+		mEntries.resize(TypeInfo::GetTypeCount());
+	}
+
+	GCTypeCensusEntry& entry = mEntries[typeId];
+	entry.Type = &type;
+
+	return entry;
+}
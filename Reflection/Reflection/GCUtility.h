@@ -1,13 +1,50 @@
 #pragma once
 
+#include <new>
+#include <type_traits>
+
+template <typename T>
+concept DeferredFinalization = requires
+{
+	T::bDeferredFinalization;
+} && T::bDeferredFinalization && !std::is_trivially_destructible_v<T>;
+
 template <typename T, typename... Args>
 T* NewGCObject(class GCManager& gcManager, Args&&... args)
 {
 	static_assert(std::is_base_of_v<GCObject, T>, "NewGCObject requires T to be derived from GCObject");
 
-	T* object = new T(std::forward<Args>(args)...);
-	gcManager.AddObject(object);
+	static_assert(alignof(T) <= GCHeap::SLOT_ALIGNMENT, "NewGCObject requires alignment not greater than GCHeap::SLOT_ALIGNMENT");
+
+	void* memory = gcManager.AllocateObject(sizeof(T));
+	T* object = nullptr;
+
+	// new T 처럼 생성자가 던지면 메모리를 돌려주고 다시 던진다, 등록 전이므로 수집기는 이 슬롯을 모른다
+	try
+	{
+		object = new (memory) T(std::forward<Args>(args)...);
+	}
+	catch (...)
+	{
+		gcManager.DeallocateObject(memory);
+		throw;
+	}
+
+	gcManager.AddObject(object, DeferredFinalization<T>);
 
 	return object;
 }
 
+// 리플렉션(Property::Set)을 거치지 않고 GCObject* 를 필드에 직접 대입할 때 사용
+// ex) GC_STORE(current, mNext, next);
+#define GC_STORE(Owner, Member, Value) \
+	do \
+	{ \
+		auto&& gcStoreValue = (Value); \
+		GCManager::WriteBarrier((Owner), gcStoreValue); \
+		(Owner)->Member = gcStoreValue; \
+	} while (false)
+
+// 컨테이너에 GCObject* 를 추가하는 등 직접 대입이 아닌 경우 저장 직전에 호출
+// ex) GC_WRITE_BARRIER(current, other); current->mRandoms.push_back(other);
+#define GC_WRITE_BARRIER(Owner, Value) GCManager::WriteBarrier((Owner), (Value))
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cassert>
+#include <ostream>
+#include <type_traits>
+
+#include "GCObject.h"
+
+// 대상을 살려 두지 않는 GCObject 참조, 대상이 수집되면 GC 가 스윕 전에 nullptr 로 바꾼다
+// PROPERTY 로 등록된 필드와 순차 컨테이너(vector 등)의 원소만 관리된다
+// GCRegion 의 객체는 가리킬 수 없다, 수집기가 마킹하지 않으므로 영역이 살아 있어도 죽은 것으로 보고 비운다
+template <typename T>
+class GCWeakPtr
+{
+public:
+	// TypeInfo 가 약한 참조 타입을 알아보는 표시
+	static constexpr bool bWeakReference = true;
+
+	GCWeakPtr() = default;
+	GCWeakPtr(T* object)
+		: mObject(object)
+	{
+		static_assert(std::is_base_of_v<GCObject, T>, "GCWeakPtr requires T to be derived from GCObject");
+		assert(object == nullptr || !GCHeap::IsRegion(object));
+	}
+
+	GCWeakPtr& operator=(T* object)
+	{
+		assert(object == nullptr || !GCHeap::IsRegion(object));
+		mObject = object;
+		return *this;
+	}
+
+	// 대상이 수집되었으면 nullptr, 로드 한 번으로 확인
+	T* Get() const { return static_cast<T*>(mObject); }
+	T* operator->() const { return Get(); }
+	explicit operator bool() const { return mObject != nullptr; }
+
+	void Reset() { mObject = nullptr; }
+
+	bool operator==(const GCWeakPtr& other) const { return mObject == other.mObject; }
+
+	friend std::ostream& operator<<(std::ostream& os, const GCWeakPtr& weakPtr)
+	{
+		return os << weakPtr.mObject;
+	}
+
+private:
+	// GC 는 이 필드를 GCObject* 슬롯으로 보고 직접 비우거나 옮긴다
+	GCObject* mObject = nullptr;
+};
+
+static_assert(sizeof(GCWeakPtr<GCObject>) == sizeof(GCObject*), "GCWeakPtr must be a single GCObject* slot");
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <cassert>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "GCWorkerPool.h"
+
+GCWorkerPool::GCWorkerPool(size_t threadCount, bool bPinThreads)
+	: mbPinned(bPinThreads)
+{
+	assert(threadCount > 0);
+	mThreads.reserve(threadCount);
+
+	for (size_t i = 0; i < threadCount; ++i)
+	{
+		mThreads.emplace_back(&GCWorkerPool::workerLoop, this, i);
+
+		if (bPinThreads)
+		{
+			pinThread(mThreads.back(), i % std::max<size_t>(1, std::thread::hardware_concurrency()));
+		}
+	}
+}
+
+GCWorkerPool::~GCWorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mbStop = true;
+	}
+
+	mWakeCondition.notify_all();
+
+	for (std::thread& thread : mThreads)
+	{
+		thread.join();
+	}
+}
+
+void GCWorkerPool::Run(const Job& job)
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	assert(mJob == nullptr && "GCWorkerPool::Run - nested run is not supported");
+
+	mJob = &job;
+	mRunningCount = mThreads.size();
+	++mGeneration;
+
+	mWakeCondition.notify_all();
+	mDoneCondition.wait(lock, [this]() { return mRunningCount == 0; });
+
+	mJob = nullptr;
+}
+
+void GCWorkerPool::RunAsync(Job job)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	assert(mJob == nullptr && "GCWorkerPool::RunAsync - nested run is not supported");
+
+	mAsyncJob = std::move(job);
+	mJob = &mAsyncJob;
+	mRunningCount = mThreads.size();
+	++mGeneration;
+
+	mWakeCondition.notify_all();
+}
+
+void GCWorkerPool::Wait()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mDoneCondition.wait(lock, [this]() { return mRunningCount == 0; });
+
+	mJob = nullptr;
+}
+
+bool GCWorkerPool::IsIdle()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mRunningCount == 0;
+}
+
+void GCWorkerPool::workerLoop(size_t workerIndex)
+{
+	uint64_t lastGeneration = 0;
+
+	while (true)
+	{
+		const Job* job = nullptr;
+
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mWakeCondition.wait(lock, [this, lastGeneration]() { return mbStop || mGeneration != lastGeneration; });
+
+			if (mbStop)
+			{
+				return;
+			}
+
+			lastGeneration = mGeneration;
+			job = mJob;
+		}
+
+		(*job)(workerIndex);
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			if (--mRunningCount == 0)
+			{
+				mDoneCondition.notify_one();
+			}
+		}
+	}
+}
+
+void GCWorkerPool::pinThread(std::thread& thread, size_t cpuIndex)
+{
+#ifdef _WIN32
+	SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << cpuIndex);
+#else
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	CPU_SET(cpuIndex, &cpuSet);
+	pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet);
+#endif
+}
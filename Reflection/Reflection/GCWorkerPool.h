@@ -0,0 +1,59 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// GC 마크/스윕 단계가 함께 쓰는 상주 워커 스레드 풀
+// 워커는 작업이 없을 때 조건 변수에서 대기한다
+class GCWorkerPool final
+{
+public:
+	using Job = std::function<void(size_t workerIndex)>;
+
+	GCWorkerPool(size_t threadCount, bool bPinThreads);
+	~GCWorkerPool();
+	GCWorkerPool(const GCWorkerPool&) = delete;
+	GCWorkerPool& operator=(const GCWorkerPool&) = delete;
+
+	// 모든 워커가 job(workerIndex)를 한 번씩 실행하고 끝날 때까지 대기
+	void Run(const Job& job);
+	// job 을 복사해 두고 기다리지 않고 반환, 끝났는지는 IsIdle 로 확인하고 Wait 로 정리한다
+	void RunAsync(Job job);
+	void Wait();
+	bool IsIdle();
+
+	inline size_t GetThreadCount() const;
+	inline bool IsPinned() const;
+
+private:
+	void workerLoop(size_t workerIndex);
+	static void pinThread(std::thread& thread, size_t cpuIndex);
+
+private:
+	std::vector<std::thread> mThreads;
+	bool mbPinned = false;
+
+	std::mutex mMutex;
+	std::condition_variable mWakeCondition;
+	std::condition_variable mDoneCondition;
+
+	const Job* mJob = nullptr;
+	Job mAsyncJob;
+	uint64_t mGeneration = 0;
+	size_t mRunningCount = 0;
+	bool mbStop = false;
+};
+
+inline size_t GCWorkerPool::GetThreadCount() const
+{
+	return mThreads.size();
+}
+
+inline bool GCWorkerPool::IsPinned() const
+{
+	return mbPinned;
+}
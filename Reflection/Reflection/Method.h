@@ -15,7 +15,7 @@
 		\
 	} regist_##Name;
 
-// non template class   ̽ Ŭ
+// non template class에서 참조를 위한 베이스 클래스
 class CallableBase
 {
 	GENERATE_TYPE_INFO(CallableBase)
@@ -24,7 +24,7 @@ public:
 	virtual ~CallableBase() = default;
 };
 
-//  ϰ ø Ű ȯ  ø ̽ Ŭ
+// 구현을 강제하고 템플릿 매개변수로 형변환을 위한 템플릿 인터페이스 클래스
 template <typename TRet, typename... TArgs>
 class ICallable : public CallableBase
 {
@@ -119,7 +119,7 @@ private:
 class Method
 {
 public:
-	// Ϲ Լ 
+	// 일반 함수 포인터
 	template <typename TRet, typename... TArgs>
 	Method(TypeInfo& owner, [[maybe_unused]] TRet(*ptr)(TArgs...), const char* name, const CallableBase& callable) :
 		mName(name),
@@ -129,7 +129,7 @@ public:
 		owner.addMethod(this);
 	}
 
-	// ɹ Լ non-const
+	// 맴버 함수 non-const
 	template <typename TClass, typename TRet, typename... TArgs>
 	Method(TypeInfo& owner, [[maybe_unused]] TRet(TClass::* ptr)(TArgs...), const char* name, const CallableBase& callable) :
 		mName(name),
@@ -139,7 +139,7 @@ public:
 		owner.addMethod(this);
 	}
 
-	// ɹ Լ const
+	// 맴버 함수 const
 	template <typename TClass, typename TRet, typename... TArgs>
 	Method(TypeInfo& owner, [[maybe_unused]] TRet(TClass::* ptr)(TArgs...) const, const char* name, const CallableBase& callable) :
 		mName(name),
@@ -152,7 +152,7 @@ public:
 	template <typename TRet, typename... TArgs>
 	TRet Invoke(void* caller, TArgs&&... args) const
 	{
-		// 1. ȯ Ÿ ˻
+		// 1. 반환 타입 검사
 		const TypeInfo& returnType = TypeInfo::GetStaticTypeInfo<TRet>();
 
 		if (!returnType.IsChildOf(*mReturnType))
@@ -172,7 +172,7 @@ public:
 			}
 		}
 
-		// 2. Ű ˻
+		// 2. 매개변수 검사
 		std::vector<const TypeInfo*> callTypes = { &TypeInfo::GetStaticTypeInfo<TArgs>()... };
 
 		if (callTypes.size() != mParameterTypes.size())
@@ -202,7 +202,7 @@ public:
 			}
 		}
 
-		// 3. Լ ȣ
+		// 3. 함수 호출
 		auto* concrete = static_cast<const ICallable<TRet, TArgs...>*>(&mCallable);
 		if constexpr (std::same_as<TRet, void>)
 		{
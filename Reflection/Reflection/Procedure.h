@@ -18,7 +18,7 @@
 class Procedure
 {
 public:
-	// Ϲ Լ 
+	// 일반 함수 포인터
 	template <typename TRet, typename... TArgs>
 	Procedure(TypeInfo& owner, [[maybe_unused]] TRet(*ptr)(TArgs...), const char* name, const CallableBase& callable)
 		: mName(name)
@@ -29,7 +29,7 @@ public:
 		owner.addProcedure(this);
 	}
 
-	// ɹ Լ non-const
+	// 맴버 함수 non-const
 	template <typename TClass, typename... TArgs>
 	Procedure(TypeInfo& owner, [[maybe_unused]] void(TClass::* ptr)(TArgs...), const char* name, const CallableBase& callable)
 		: mName(name)
@@ -39,7 +39,7 @@ public:
 		owner.addProcedure(this);
 	}
 
-	// ɹ Լ const
+	// 맴버 함수 const
 	template <typename TClass, typename... TArgs>
 	Procedure(TypeInfo& owner, [[maybe_unused]] void(TClass::* ptr)(TArgs...) const, const char* name, const CallableBase& callable)
 		: mName(name)
@@ -54,7 +54,7 @@ public:
 	{
 		std::vector<const TypeInfo*> callTypes = { &TypeInfo::GetStaticTypeInfo<TArgs>()... };
 
-		// 1. Ű ˻
+		// 1. 매개변수 검사
 		if (callTypes.size() != mParameterTypes.size())
 		{
 			assert(false && "Procedure::Invoke - Argument count mismatch");
@@ -73,7 +73,7 @@ public:
 			}
 		}
 
-		// 2. Լ ȣ
+		// 2. 함수 호출
 		auto concreteCallable = static_cast<const ICallable<void, TArgs...>*>(&mCallable);
 		concreteCallable->Invoke(caller, std::forward<TArgs>(args)...);
 	}
@@ -119,7 +119,7 @@ class ProcedureRegister
 public:
 	ProcedureRegister(const char* name, TypeInfo& typeInfo)
 	{
-		// ɹ Լ
+		// 맴버 함수
 		if constexpr (std::is_member_function_pointer_v<TPtr>)
 		{
 			// const
@@ -138,7 +138,7 @@ public:
 		else
 		{
 
-			// static Լ
+			// static 함수
 			TClass* forTypeDeduction = nullptr;
 			static StaticCallable callable(forTypeDeduction, Ptr);
 			static Procedure procedure(typeInfo, Ptr, name, callable);
@@ -11,11 +11,11 @@
 	{ \
 		RegistPropertyExecutor_##Name() \
 		{ \
-			static PropertyRegister<ThisType, decltype(Name), decltype(&ThisType::Name), &ThisType::##Name> property_register_##Name{ #Name, ThisType::StaticTypeInfo() }; \
+			static PropertyRegister<ThisType, decltype(Name), decltype(&ThisType::Name), &ThisType::Name> property_register_##Name{ #Name, ThisType::StaticTypeInfo() }; \
 		} \
 	} regist_##Name; \
 
-// non template class   ̽ Ŭ
+// non template class에서 참조를 위한 베이스 클래스
 class PropertyHandlerBase
 {
 	GENERATE_TYPE_INFO(PropertyHandlerBase)
@@ -24,9 +24,11 @@ public:
 	virtual ~PropertyHandlerBase() = default;
 
 	virtual void* GetRawPointer(void* object) const = 0;
+	virtual size_t GetOffset() const = 0;
+	virtual bool IsStatic() const = 0;
 };
 
-//  ϰ ø Ű ȯ  ø ̽ Ŭ
+// 구현을 강제하고 템플릿 매개변수로 형변환을 위한 템플릿 인터페이스 클래스
 template <typename T>
 class IPropertyHandler : public PropertyHandlerBase
 {
@@ -78,9 +80,20 @@ public:
 		return static_cast<void*>(&(static_cast<TClass*>(object)->*mPtr));
 	}
 
+	// 멤버 포인터로부터 객체 시작 주소 기준 오프셋 계산 (offsetof와 같은 방식)
+	virtual size_t GetOffset() const override
+	{
+		return reinterpret_cast<size_t>(&(reinterpret_cast<const volatile TClass*>(0)->*mPtr));
+	}
+
+	virtual bool IsStatic() const override
+	{
+		return false;
+	}
+
 private:
-	template <typename T>
-	void set(T& dest, const T& src) const {
+	template <typename U>
+	void set(U& dest, const U& src) const {
 		dest = src;
 	}
 
@@ -138,6 +151,16 @@ public:
 		return mPtr;
 	}
 
+	virtual size_t GetOffset() const override
+	{
+		return 0;
+	}
+
+	virtual bool IsStatic() const override
+	{
+		return true;
+	}
+
 private:
 	T* mPtr = nullptr;
 };
@@ -197,6 +220,26 @@ public:
 	virtual ~BaseIteratorHandler() = default;
 	virtual std::unique_ptr<IteratorWrapperBase> Begin(void* object) const = 0;
 	virtual std::unique_ptr<IteratorWrapperBase> End(void* object) const = 0;
+
+	// 원소가 연속된 메모리에 있는 컨테이너라면 시작 주소를, 아니라면 nullptr 반환
+	virtual void* GetData(void* object) const = 0;
+	virtual size_t GetCount(void* object) const = 0;
+
+	// set/map 처럼 원소 값으로 정렬, 해시되는 컨테이너면 true, 원소를 제자리에서 바꾸면 안 된다
+	virtual bool IsAssociative() const = 0;
+};
+
+template <typename T>
+concept ContiguousContainer = requires(T & container)
+{
+	container.data();
+	container.size();
+};
+
+template <typename T>
+concept AssociativeContainer = requires
+{
+	typename T::key_type;
 };
 
 template <typename T>
@@ -224,26 +267,61 @@ public:
 
 		return std::make_unique<IteratorWrapper<Iterator>>(static_cast<T*>(object)->end());
 	}
+
+	void* GetData(void* object) const override
+	{
+		if constexpr (ContiguousContainer<T>)
+		{
+			return (void*)static_cast<T*>(object)->data();
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+
+	size_t GetCount(void* object) const override
+	{
+		if constexpr (ContiguousContainer<T>)
+		{
+			return static_cast<T*>(object)->size();
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	bool IsAssociative() const override
+	{
+		return AssociativeContainer<T>;
+	}
 };
 
 using PrintFuncPtr = void(*)(void*, int);
 
+// 포인터 프로퍼티를 Set 으로 바꾸기 직전에 호출되는 쓰기 장벽 (GC 가 등록)
+using PropertyWriteBarrier = void(*)(const Property& property, void* object, const void* oldValue, const void* newValue);
+
 struct PropertyInitializer
 {
 	const char* mName = nullptr;
 	const TypeInfo& mType;
 	const PropertyHandlerBase& mHandler;
 	PrintFuncPtr mPrintFunc = nullptr;
+	BaseIteratorHandler* mIteratorHandler = nullptr;
 };
 
 class Property
 {
 public:
 	Property(TypeInfo& owner, const PropertyInitializer& initializer)
-		: mName(initializer.mName)
+		: mOwner(owner)
+		, mName(initializer.mName)
 		, mType(initializer.mType)
 		, mHandler(initializer.mHandler)
 		, mPrintFunc(initializer.mPrintFunc)
+		, mIteratorHandler(initializer.mIteratorHandler)
 	{
 		owner.addProperty(this);
 	}
@@ -271,6 +349,15 @@ public:
 		}
 
 		auto concreteHandler = static_cast<const IPropertyHandler<T>*>(&mHandler);
+
+		if constexpr (std::is_pointer_v<T>)
+		{
+			if (mWriteBarrier != nullptr)
+			{
+				mWriteBarrier(*this, object, concreteHandler->Get(object), value);
+			}
+		}
+
 		concreteHandler->Set(object, value);
 	}
 
@@ -362,12 +449,21 @@ public:
 
 	inline const char* GetName() const;
 	inline const TypeInfo& GetTypeInfo() const;
+	inline const TypeInfo& GetOwnerTypeInfo() const;
 	inline void* GetRawPointer(void* object) const;
+	inline size_t GetOffset() const;
+	inline bool IsStatic() const;
 
 	inline void SetIteratorHandler(BaseIteratorHandler* handler);
 	inline bool HasIterator() const;
+	inline const BaseIteratorHandler* GetIteratorHandler() const;
+
+	static inline void SetWriteBarrier(PropertyWriteBarrier writeBarrier);
 
 private:
+	inline static PropertyWriteBarrier mWriteBarrier = nullptr;
+
+	const TypeInfo& mOwner;
 
 	const char* mName = nullptr;
 	const TypeInfo& mType;
@@ -412,11 +508,26 @@ inline const TypeInfo& Property::GetTypeInfo() const
 	return mType;
 }
 
+inline const TypeInfo& Property::GetOwnerTypeInfo() const
+{
+	return mOwner;
+}
+
 inline void* Property::GetRawPointer(void* object) const
 {
 	return mHandler.GetRawPointer(object);
 }
 
+inline size_t Property::GetOffset() const
+{
+	return mHandler.GetOffset();
+}
+
+inline bool Property::IsStatic() const
+{
+	return mHandler.IsStatic();
+}
+
 inline void Property::SetIteratorHandler(BaseIteratorHandler* handler)
 {
 	mIteratorHandler = handler;
@@ -427,7 +538,17 @@ inline bool Property::HasIterator() const
 	return mIteratorHandler != nullptr;
 }
 
-// νϽ ɹ  Լ( Ÿӿ Լ  ĸó)
+inline const BaseIteratorHandler* Property::GetIteratorHandler() const
+{
+	return mIteratorHandler;
+}
+
+inline void Property::SetWriteBarrier(PropertyWriteBarrier writeBarrier)
+{
+	mWriteBarrier = writeBarrier;
+}
+
+// 인스턴스의 맴버값 출력 함수(컴파일 타임에 함수 포인터 캡처함)
 template <typename T>
 concept OstreamWritable = requires(std::ostream & os, T value)
 {
@@ -532,35 +653,38 @@ void Print(void* object, int indent)
 	}
 }
 
+template <typename T>
+BaseIteratorHandler* GetIteratorHandlerOrNull()
+{
+	if constexpr (IsIterable<T>::value)
+	{
+		static TemplateIteratorHandler<T> iterHandler;
+		return &iterHandler;
+	}
+	else
+	{
+		return nullptr;
+	}
+}
+
 template <typename TClass, typename T, typename TPtr, TPtr ptr>
 class PropertyRegister
 {
 public:
 	PropertyRegister(const char* name, TypeInfo& typeInfo)
 	{
+		// 참조 맵 생성을 위해 이터레이터 핸들러는 프로퍼티 등록 전에 준비
 		if constexpr (std::is_member_pointer_v<TPtr>)
 		{
 			static PropertyHandler<TClass, T> handler(ptr);
-			static PropertyInitializer initializer = { .mName = name, .mType = TypeInfo::GetStaticTypeInfo<T>(), .mHandler = handler, .mPrintFunc = &Print<T> };
+			static PropertyInitializer initializer = { .mName = name, .mType = TypeInfo::GetStaticTypeInfo<T>(), .mHandler = handler, .mPrintFunc = &Print<T>, .mIteratorHandler = GetIteratorHandlerOrNull<T>() };
 			static Property property(typeInfo, initializer);
-
-			if constexpr (IsIterable<T>::value)
-			{
-				static TemplateIteratorHandler<T> iterHandler;
-				property.SetIteratorHandler(&iterHandler);
-			}
 		}
 		else
 		{
 			static StaticPropertyHandler<TClass, T> handler(ptr);
-			static PropertyInitializer initializer = { .mName = name, .mType = TypeInfo::GetStaticTypeInfo<T>(), .mHandler = handler, .mPrintFunc = &Print<T> };
+			static PropertyInitializer initializer = { .mName = name, .mType = TypeInfo::GetStaticTypeInfo<T>(), .mHandler = handler, .mPrintFunc = &Print<T>, .mIteratorHandler = GetIteratorHandlerOrNull<T>() };
 			static Property property(typeInfo, initializer);
-
-			if constexpr (IsIterable<T>::value)
-			{
-				static TemplateIteratorHandler<T> iterHandler;
-				property.SetIteratorHandler(&iterHandler);
-			}
 		}
 	}
-};
+};
\ No newline at end of file
@@ -2,8 +2,8 @@
 
 #define GENERATE_TYPE_INFO(TypeName) \
 private: \
-	friend SuperClassTypeDeduction; \
-	friend TypeInfoInitializer; \
+	template <typename, typename> friend struct SuperClassTypeDeduction; \
+	template <typename> friend struct TypeInfoInitializer; \
 \
 public: \
 	using Super = typename SuperClassTypeDeduction<TypeName>::Type; \
@@ -30,7 +30,7 @@ private: \
 	{ \
 		RegistPropertyExecutor_##Name() \
 		{ \
-			static PropertyRegister<ThisType, decltype(Name), decltype(&ThisType::Name), &ThisType::##Name> property_register_##Name{ #Name, ThisType::StaticTypeInfo() }; \
+			static PropertyRegister<ThisType, decltype(Name), decltype(&ThisType::Name), &ThisType::Name> property_register_##Name{ #Name, ThisType::StaticTypeInfo() }; \
 		} \
 	} regist_##Name; \
 
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cassert>
+#include <vector>
+
+// 용량이 고정된 원형 버퍼, 가득 차면 가장 오래된 원소를 덮어쓴다
+// 덮어쓸 때 대입을 사용하므로 원소가 가진 vector 등의 용량이 재사용된다
+template <typename T>
+class RingBuffer
+{
+public:
+	explicit RingBuffer(size_t capacity = 0)
+		: mItems(capacity)
+	{
+	}
+
+	// 기존 원소는 모두 버린다
+	void Resize(size_t capacity)
+	{
+		mItems.assign(capacity, T());
+		mHead = 0;
+		mSize = 0;
+	}
+
+	void Push(const T& value)
+	{
+		const size_t capacity = mItems.size();
+
+		if (capacity == 0)
+		{
+			return;
+		}
+
+		mItems[(mHead + mSize) % capacity] = value;
+
+		if (mSize < capacity)
+		{
+			++mSize;
+		}
+		else
+		{
+			mHead = (mHead + 1) % capacity;
+		}
+	}
+
+	// 0 이 가장 오래된 원소
+	const T& operator[](size_t index) const
+	{
+		assert(index < mSize);
+		return mItems[(mHead + index) % mItems.size()];
+	}
+
+	const T& Back() const
+	{
+		assert(mSize > 0);
+		return (*this)[mSize - 1];
+	}
+
+	void Clear()
+	{
+		mHead = 0;
+		mSize = 0;
+	}
+
+	size_t GetSize() const { return mSize; }
+	size_t GetCapacity() const { return mItems.size(); }
+	bool IsEmpty() const { return mSize == 0; }
+
+private:
+	std::vector<T> mItems;
+	size_t mHead = 0;
+	size_t mSize = 0;
+};
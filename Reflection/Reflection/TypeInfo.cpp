@@ -4,16 +4,17 @@
 #include "Property.h"
 #include "Method.h"
 #include "Procedure.h"
+#include "GCObject.h"
 
 void TypeInfo::PrintTypeInfo(int indent) const
 {
 	std::string indentStr(indent * 4, ' ');
 	std::cout << indentStr << "{\n";
 
-	// TypeName 
+	// TypeName 출력
 	std::cout << indentStr << "    \"TypeName\": \"" << GetName() << "\",\n";
 
-	//   Լ
+	// 재사용된 출력 함수들
 	PrintProperties(indent + 1);
 
 	if (!GetMethods().empty())
@@ -36,10 +37,10 @@ void TypeInfo::PrintTypeInfoValues(void* object, int indent) const
 	std::string indentStr(indent * 4, ' ');
 	std::cout << indentStr << "{\n";
 
-	// TypeName 
+	// TypeName 출력
 	std::cout << indentStr << "    \"TypeName\": \"" << GetName() << "\",\n";
 
-	//   Լ
+	// 재사용된 출력 함수들
 	PrintPropertyValues(object, indent + 1);
 
 	if (!GetMethods().empty())
@@ -174,6 +175,7 @@ void TypeInfo::addProperty(const Property* property)
 {
 	mProperties.emplace_back(property);
 	mPropertyMap.emplace(property->GetName(), property);
+	addReference(property);
 }
 void TypeInfo::addProcedure(const Procedure* procedure)
 {
@@ -181,6 +183,43 @@ void TypeInfo::addProcedure(const Procedure* procedure)
 	mProcedureMap[procedure->GetName()] = procedure;
 }
 
+void TypeInfo::addReference(const Property* property)
+{
+	const TypeInfo& propertyType = property->GetTypeInfo();
+
+	if (propertyType.IsChildOf<GCObject*>())
+	{
+		if (property->IsStatic())
+		{
+			mReferenceMap.StaticSlots.push_back(property->GetRawPointer(nullptr));
+		}
+		else
+		{
+			mReferenceMap.Offsets.push_back(property->GetOffset());
+		}
+	}
+	else if (propertyType.IsIterable()
+		&& property->HasIterator()
+		&& !property->IsStatic()
+		&& propertyType.GetIteratorElementType()->IsChildOf<GCObject*>())
+	{
+		mReferenceMap.Containers.push_back({ property->GetOffset(), property->GetIteratorHandler() });
+	}
+	else if (propertyType.IsWeakReference() && !property->IsStatic())
+	{
+		mReferenceMap.WeakOffsets.push_back(property->GetOffset());
+	}
+	else if (propertyType.IsIterable()
+		&& property->HasIterator()
+		&& !property->IsStatic()
+		&& propertyType.GetIteratorElementType()->IsWeakReference())
+	{
+		// 원소를 nullptr 로 바꾸면 정렬 순서가 깨지므로 set/map 은 지원하지 않는다
+		assert(!property->GetIteratorHandler()->IsAssociative() && "GCWeakPtr in associative containers is not supported");
+		mReferenceMap.WeakContainers.push_back({ property->GetOffset(), property->GetIteratorHandler() });
+	}
+}
+
 void TypeInfo::collectSuperMethods()
 {
 	assert(mSuper != nullptr);
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <concepts>
+#include <cstdint>
 #include <map>
+#include <new>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -11,8 +14,8 @@
 
 #define GENERATE_TYPE_INFO(TypeName) \
 private: \
-	friend SuperClassTypeDeduction; \
-	friend TypeInfoInitializer; \
+	template <typename, typename> friend struct SuperClassTypeDeduction; \
+	template <typename> friend struct TypeInfoInitializer; \
 \
 public: \
 	using Super = typename SuperClassTypeDeduction<TypeName>::Type; \
@@ -38,6 +41,7 @@ class Method;
 class Procedure;
 class Property;
 class TypeInfo;
+class BaseIteratorHandler;
 
 template <typename T>
 concept HasSuper = requires
@@ -81,49 +85,71 @@ struct HasValueType<T, std::void_t<typename T::value_type>> : std::true_type {};
 template <typename T>
 struct TypeInfoInitializer
 {
-	TypeInfoInitializer(const std::string& name)
-		: mName(name)
-	{
-		if constexpr (HasSuper<T>)
-		{
-			mSuper = &(typename T::Super::StaticTypeInfo());
-		}
-		if constexpr (std::is_array_v<T>)
-		{
-			using ElementType = std::remove_all_extents_t<T>;
-			mElementType = &TypeInfo::template GetStaticTypeInfo<ElementType>();
-		}
-		if constexpr (IsIterable<T>::value && HasValueType<T>::value)
-		{
-			mIsIterable = true;
-			using ElementType = typename T::value_type;
-			mIteratorElementType = &TypeInfo::template GetStaticTypeInfo<ElementType>();
-		}
-	}
+	// TypeInfo 의 정적 함수를 쓰므로 TypeInfo 정의 뒤에서 정의
+	TypeInfoInitializer(const std::string& name);
 
 	const std::string mName = nullptr;
 	const TypeInfo* mSuper = nullptr;
 	const TypeInfo* mElementType = nullptr;
 	bool mIsIterable = false;
 	const TypeInfo* mIteratorElementType = nullptr;
+	bool mIsWeakReference = false;
+	void (*mRelocator)(void* destination, void* source) = nullptr;
 };
 
 
-// T Ÿκ ̸ 
+// T 타입으로부터 이름 추출
+// MSVC: "... ExtractTypeName<int>(void)", GCC: "... ExtractTypeName() [with T = int; ...]", Clang: "... [T = int]"
 template <typename T>
 std::string ExtractTypeName()
 {
+#if defined(_MSC_VER)
 	std::string_view sig = __FUNCSIG__;
+	constexpr std::string_view prefix = "ExtractTypeName<";
+#else
+	std::string_view sig = __PRETTY_FUNCTION__;
+	constexpr std::string_view prefix = "T = ";
+#endif
 
-	auto start = sig.find("ExtractTypeName<") + strlen("ExtractTypeName<");
-	auto end = sig.find(">(void)");
+	auto start = sig.find(prefix);
 
-	if (start == std::string_view::npos || end == std::string_view::npos || end <= start)
+	if (start == std::string_view::npos)
+		return std::string(sig);
+
+	start += prefix.size();
+
+#if defined(_MSC_VER)
+	auto end = sig.rfind(">(void)");
+#else
+	auto end = sig.find_first_of(";]", start);
+#endif
+
+	if (end == std::string_view::npos || end <= start)
 		return std::string(sig);
 
 	return std::string(sig.substr(start, end - start));
 }
 
+// GCObject* 를 담은 컨테이너 프로퍼티의 위치와 순회 방법
+struct ContainerReference
+{
+	size_t Offset = 0;
+	const BaseIteratorHandler* IteratorHandler = nullptr;
+};
+
+// 타입 등록 시 한 번 만들어지는 GCObject* 참조 위치 목록
+// GC 마킹은 프로퍼티 전체 대신 이 목록만 순회한다
+struct ReferenceMap
+{
+	std::vector<size_t> Offsets;
+	std::vector<ContainerReference> Containers;
+	std::vector<void*> StaticSlots;
+
+	// GCWeakPtr 필드와 GCWeakPtr 컨테이너, 마킹하지 않고 대상이 죽으면 비운다
+	std::vector<size_t> WeakOffsets;
+	std::vector<ContainerReference> WeakContainers;
+};
+
 class TypeInfo
 {
 	friend class Method;
@@ -131,9 +157,13 @@ class TypeInfo
 	friend class Procedure;
 
 public:
+	// source 를 destination 으로 이동 생성한 뒤 source 를 소멸, GC 압축에서 객체를 옮길 때 사용
+	using Relocator = void(*)(void* destination, void* source);
+
 	template <typename T>
 	explicit TypeInfo(const TypeInfoInitializer<T>& initializer)
 		: mTypeHash(typeid(T).hash_code())
+		, mTypeId(mTypeCount.fetch_add(1, std::memory_order_relaxed))
 		, mName(initializer.mName)
 		, mFullName(typeid(T).name())
 		, mSuper(initializer.mSuper)
@@ -143,6 +173,8 @@ public:
 		, mElementType(initializer.mElementType)
 		, mIsIterable(initializer.mIsIterable)
 		, mIteratorElementType(initializer.mIteratorElementType)
+		, mIsWeakReference(initializer.mIsWeakReference)
+		, mRelocator(initializer.mRelocator)
 	{
 		if constexpr (HasSuper<T>)
 		{
@@ -214,17 +246,31 @@ public:
 	inline bool IsIterable() const;
 	inline const TypeInfo* GetIteratorElementType() const;
 
+	inline bool IsWeakReference() const;
+
+	// 생성 순서대로 0부터 매긴 번호, 타입별 통계를 배열로 모을 때 사용
+	inline uint32_t GetTypeId() const;
+	inline static uint32_t GetTypeCount();
+
+	inline const ReferenceMap& GetReferenceMap() const;
+	// 이동 생성할 수 없는 타입이면 nullptr
+	inline Relocator GetRelocator() const;
+
 private:
 	void addMethod(const Method* method);
 	void addProperty(const Property* property);
 	void addProcedure(const Procedure* property);
+	void addReference(const Property* property);
 
 	void collectSuperMethods();
 	void collectSuperProperties();
 	void collectSuperProcedures();
 
 private:
+	inline static std::atomic<uint32_t> mTypeCount = 0;
+
 	size_t mTypeHash;
+	uint32_t mTypeId;
 	const std::string mName;
 	std::string mFullName;
 	const TypeInfo* mSuper = nullptr;
@@ -247,8 +293,47 @@ private:
 
 	bool mIsIterable = false;
 	const TypeInfo* mIteratorElementType = nullptr;
+
+	bool mIsWeakReference = false;
+
+	ReferenceMap mReferenceMap;
+	Relocator mRelocator = nullptr;
 };
 
+template <typename T>
+TypeInfoInitializer<T>::TypeInfoInitializer(const std::string& name)
+	: mName(name)
+{
+	if constexpr (HasSuper<T>)
+	{
+		mSuper = &T::Super::StaticTypeInfo();
+	}
+	if constexpr (std::is_array_v<T>)
+	{
+		using ElementType = std::remove_all_extents_t<T>;
+		mElementType = &TypeInfo::GetStaticTypeInfo<ElementType>();
+	}
+	if constexpr (IsIterable<T>::value && HasValueType<T>::value)
+	{
+		mIsIterable = true;
+		using ElementType = typename T::value_type;
+		mIteratorElementType = &TypeInfo::GetStaticTypeInfo<ElementType>();
+	}
+	if constexpr (requires { T::bWeakReference; })
+	{
+		mIsWeakReference = T::bWeakReference;
+	}
+	if constexpr (std::is_class_v<T> && std::is_move_constructible_v<T> && std::is_destructible_v<T>)
+	{
+		mRelocator = [](void* destination, void* source)
+			{
+				T* sourceObject = static_cast<T*>(source);
+				new (destination) T(std::move(*sourceObject));
+				sourceObject->~T();
+			};
+	}
+}
+
 inline bool TypeInfo::IsA(const TypeInfo& other) const
 {
 	return (this == &other) || (mTypeHash == other.mTypeHash);
@@ -354,4 +439,29 @@ inline bool TypeInfo::IsIterable() const
 inline const TypeInfo* TypeInfo::GetIteratorElementType() const
 {
 	return mIteratorElementType;
+}
+
+inline bool TypeInfo::IsWeakReference() const
+{
+	return mIsWeakReference;
+}
+
+inline uint32_t TypeInfo::GetTypeId() const
+{
+	return mTypeId;
+}
+
+inline uint32_t TypeInfo::GetTypeCount()
+{
+	return mTypeCount.load(std::memory_order_relaxed);
+}
+
+inline const ReferenceMap& TypeInfo::GetReferenceMap() const
+{
+	return mReferenceMap;
+}
+
+inline TypeInfo::Relocator TypeInfo::GetRelocator() const
+{
+	return mRelocator;
 }
\ No newline at end of file
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// Chase-Lev 작업 훔치기 덱
+// 소유 스레드는 뒤쪽에서 Push/Pop(LIFO), 다른 스레드는 앞쪽에서 Steal(FIFO)
+template <typename T>
+class WorkStealingQueue
+{
+	static_assert(std::is_trivially_copyable_v<T>, "WorkStealingQueue requires trivially copyable T");
+
+public:
+	explicit WorkStealingQueue(size_t capacity = 1024)
+		: mTop(0)
+		, mBottom(0)
+		, mBuffer(new Buffer(roundUpToPowerOfTwo(capacity)))
+	{
+	}
+
+	~WorkStealingQueue()
+	{
+		delete mBuffer.load(std::memory_order_relaxed);
+
+		for (Buffer* buffer : mRetiredBuffers)
+		{
+			delete buffer;
+		}
+	}
+
+	WorkStealingQueue(const WorkStealingQueue&) = delete;
+	WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+	// 소유 스레드 전용
+	void Push(T value)
+	{
+		const int64_t bottom = mBottom.load(std::memory_order_relaxed);
+		const int64_t top = mTop.load(std::memory_order_acquire);
+		Buffer* buffer = mBuffer.load(std::memory_order_relaxed);
+
+		if (bottom - top > static_cast<int64_t>(buffer->Capacity) - 1)
+		{
+			buffer = grow(buffer, bottom, top);
+		}
+
+		buffer->Store(bottom, value);
+		std::atomic_thread_fence(std::memory_order_release);
+		mBottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+	// 소유 스레드 전용
+	bool Pop(T& outValue)
+	{
+		const int64_t bottom = mBottom.load(std::memory_order_relaxed) - 1;
+		Buffer* buffer = mBuffer.load(std::memory_order_relaxed);
+		mBottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t top = mTop.load(std::memory_order_relaxed);
+
+		if (top > bottom)
+		{
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		outValue = buffer->Load(bottom);
+
+		if (top == bottom)
+		{
+			// 마지막 원소는 훔치는 스레드와 경쟁
+			const bool bWon = mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+			return bWon;
+		}
+
+		return true;
+	}
+
+	// 모든 스레드에서 호출 가능
+	bool Steal(T& outValue)
+	{
+		int64_t top = mTop.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64_t bottom = mBottom.load(std::memory_order_acquire);
+
+		if (top >= bottom)
+		{
+			return false;
+		}
+
+		Buffer* buffer = mBuffer.load(std::memory_order_acquire);
+		outValue = buffer->Load(top);
+
+		return mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	}
+
+	size_t GetSize() const
+	{
+		const int64_t bottom = mBottom.load(std::memory_order_relaxed);
+		const int64_t top = mTop.load(std::memory_order_relaxed);
+
+		return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+	}
+
+	bool IsEmpty() const { return GetSize() == 0; }
+
+	// 모든 스레드가 작업을 마친 뒤에만 호출
+	void Reset()
+	{
+		assert(IsEmpty() && "WorkStealingQueue::Reset - queue is not empty");
+
+		for (Buffer* buffer : mRetiredBuffers)
+		{
+			delete buffer;
+		}
+
+		mRetiredBuffers.clear();
+		mTop.store(0, std::memory_order_relaxed);
+		mBottom.store(0, std::memory_order_relaxed);
+	}
+
+private:
+	struct Buffer
+	{
+		explicit Buffer(size_t capacity)
+			: Capacity(capacity)
+			, Mask(capacity - 1)
+			, Elements(new std::atomic<T>[capacity])
+		{
+		}
+
+		~Buffer()
+		{
+			delete[] Elements;
+		}
+
+		// 원소가 가리키는 데이터(마크 패킷 등)를 훔친 스레드가 볼 수 있도록 원소 자체도 release/acquire
+		T Load(int64_t index) const { return Elements[index & Mask].load(std::memory_order_acquire); }
+		void Store(int64_t index, T value) { Elements[index & Mask].store(value, std::memory_order_release); }
+
+		const size_t Capacity;
+		const size_t Mask;
+		std::atomic<T>* Elements;
+	};
+
+	Buffer* grow(Buffer* buffer, int64_t bottom, int64_t top)
+	{
+		Buffer* newBuffer = new Buffer(buffer->Capacity * 2);
+
+		for (int64_t i = top; i < bottom; ++i)
+		{
+			newBuffer->Store(i, buffer->Load(i));
+		}
+
+		// 훔치는 스레드가 아직 읽고 있을 수 있으므로 Reset 까지 해제를 미룬다
+		mRetiredBuffers.push_back(buffer);
+		mBuffer.store(newBuffer, std::memory_order_release);
+
+		return newBuffer;
+	}
+
+	static size_t roundUpToPowerOfTwo(size_t value)
+	{
+		size_t result = 1;
+
+		while (result < value)
+		{
+			result <<= 1;
+		}
+
+		return result;
+	}
+
+private:
+	alignas(64) std::atomic<int64_t> mTop;
+	alignas(64) std::atomic<int64_t> mBottom;
+	alignas(64) std::atomic<Buffer*> mBuffer;
+	std::vector<Buffer*> mRetiredBuffers;
+};
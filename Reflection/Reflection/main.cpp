@@ -1,13 +1,26 @@
 ﻿#define _CRTDBG_MAP_ALLOC
+#ifdef _MSC_VER
 #include <crtdbg.h>
+#endif
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
 #include <vector>
 #include <string>
+#include <thread>
 
+#include "ChunkedVector.h"
 #include "FixedVector.h"
 #include "GCManager.h"
+#include "GCRegion.h"
+#include "GCRoot.h"
 #include "GCUtility.h"
+#include "GCWeakPtr.h"
 #include "GCObject.h"
 #include "TypeInfo.h"
 #include "Property.h"
@@ -18,6 +31,22 @@ void TestTypeInfo(void);
 void TestProperty(void);
 void TestMethod(void);
 void TestGC(void);
+void TestGCIncremental(void);
+void TestGCGenerational(void);
+void TestGCHeap(void);
+void TestGCRegistry(void);
+void TestGCMarkStack(void);
+void TestGCFinalization(void);
+void TestGCCompaction(void);
+void TestGCWeakPtr(void);
+void TestGCTelemetry(void);
+void TestGCTypeCensus(void);
+void TestGCTriggerPolicy(void);
+void TestGCConcurrent(void);
+void TestGCThreadAllocation(void);
+void TestGCSafepoint(void);
+void TestGCRoot(void);
+void TestGCRegion(void);
 void TestRPC(void);
 
 class TestClass
@@ -41,7 +70,9 @@ class TestClass
 
 int main()
 {
+#ifdef _MSC_VER
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
+#endif
 
 	GCManager::Create();
 
@@ -49,6 +80,22 @@ int main()
 	TestProperty();
 	TestMethod();
 	TestGC();
+	TestGCIncremental();
+	TestGCGenerational();
+	TestGCHeap();
+	TestGCRegistry();
+	TestGCMarkStack();
+	TestGCFinalization();
+	TestGCCompaction();
+	TestGCWeakPtr();
+	TestGCTelemetry();
+	TestGCTypeCensus();
+	TestGCTriggerPolicy();
+	TestGCConcurrent();
+	TestGCThreadAllocation();
+	TestGCSafepoint();
+	TestGCRoot();
+	TestGCRegion();
 	TestRPC();
 
 	GCManager::Destroy();
@@ -289,6 +336,7 @@ public:
 			for (int j = 0; j < DEPTH; ++j)
 			{
 				chain[j] = NewGCObject<TempObject>(GCManager::Get());
+				GC_WRITE_BARRIER(this, chain[j]);
 				mGCObjects.Add(chain[j]);
 			}
 
@@ -300,13 +348,13 @@ public:
 				if (j > 0)
 				{
 					TempObject* left = static_cast<TempObject*>(chain[j - 1]);
-					current->mPrev = left;
+					GC_STORE(current, mPrev, left);
 				}
 
 				if (j < DEPTH - 1)
 				{
 					TempObject* right = static_cast<TempObject*>(chain[j + 1]);
-					current->mNext = right;
+					GC_STORE(current, mNext, right);
 				}
 			}
 		}
@@ -347,6 +395,7 @@ public:
 				// 자기 자신으로 참조하거나 중복 연결 방지
 				if (to != from && std::find(from->mRandoms.begin(), from->mRandoms.end(), to) == from->mRandoms.end())
 				{
+					GC_WRITE_BARRIER(from, to);
 					from->mRandoms.push_back(to);
 				}
 			}
@@ -385,6 +434,12 @@ void TestGC(void)
 	GameInstance* gameInstances[TEST_INSTANCE_COUNT];
 	const GCDebugInfo& lastInfo = GCManager::Get().GetLastDebugInfo();
 
+	// 0. 참조 맵
+	const ReferenceMap& tempReferenceMap = TempObject::StaticTypeInfo().GetReferenceMap();
+	assert(tempReferenceMap.Offsets.size() == 2);
+	assert(tempReferenceMap.Containers.size() == 1);
+	assert(GameInstance::StaticTypeInfo().GetReferenceMap().Containers.size() == 1);
+
 	// 1. 싱글 스레드-마크
 	for (size_t i = 0; i < TEST_INSTANCE_COUNT; ++i)
 	{
@@ -445,6 +500,13 @@ void TestGC(void)
 	assert(lastInfo.RootObjectCount == 10);
 	assert(lastInfo.DeletedObjects == 0);
 
+	size_t parallelMarkedCount = 0;
+	for (const GCWorkerDebugInfo& workerInfo : lastInfo.Workers)
+	{
+		parallelMarkedCount += workerInfo.MarkedObjects;
+	}
+	assert(parallelMarkedCount == lastInfo.RemainingObjects);
+
 	// 4. 멀티 스레드-스윕
 	for (size_t i = 0; i < TEST_INSTANCE_COUNT; ++i)
 	{
@@ -485,6 +547,1366 @@ void TestGC(void)
 	GCManager::Get().Collect();
 }
 
+void TestGCIncremental(void)
+{
+	const size_t CHAIN_LENGTH = 5000;
+	const size_t GARBAGE_COUNT = 5000;
+	const GCDebugInfo& lastInfo = GCManager::Get().GetLastDebugInfo();
+
+	TempObject* root = NewGCObject<TempObject>(GCManager::Get());
+	root->SetRoot(true);
+
+	TempObject* tail = root;
+	for (size_t i = 0; i < CHAIN_LENGTH; ++i)
+	{
+		TempObject* next = NewGCObject<TempObject>(GCManager::Get());
+		GC_STORE(tail, mNext, next);
+		tail = next;
+	}
+
+	TempObject* moved = NewGCObject<TempObject>(GCManager::Get());
+	tail->mRandoms.push_back(moved);
+
+	for (size_t i = 0; i < GARBAGE_COUNT; ++i)
+	{
+		NewGCObject<TempObject>(GCManager::Get());
+	}
+
+	// 1. 첫 슬라이스 이후 루트(검은색)로 아직 방문하지 않은 객체를 옮겨도 살아남아야 함
+	GCManager::Get().CollectIncremental(1);
+	assert(GCManager::Get().GetIncrementalPhase() == GCPhase::Mark);
+
+	const Property* prevProperty = TempObject::StaticTypeInfo().GetProperty("mPrev");
+	prevProperty->Set<GCObject*>(root, moved);
+	tail->mRandoms.clear();
+
+	// 2. 수집 도중 생성해 연결한 객체도 살아남아야 함
+	TempObject* created = NewGCObject<TempObject>(GCManager::Get());
+	GC_STORE(tail, mPrev, created);
+
+	while (GCManager::Get().IsIncrementalCollecting())
+	{
+		GCManager::Get().CollectIncremental(1);
+	}
+
+	assert(lastInfo.SliceCount > 1);
+	assert(lastInfo.SlicePauseP50Us <= lastInfo.SlicePauseMaxUs);
+	assert(lastInfo.RootObjectCount == 1);
+	assert(lastInfo.DeletedObjects == GARBAGE_COUNT);
+	assert(lastInfo.RemainingObjects == CHAIN_LENGTH + 3);
+
+	root->SetRoot(false);
+	GCManager::Get().Collect();
+	assert(lastInfo.RemainingObjects == 0);
+}
+
+void TestGCGenerational(void)
+{
+	const size_t GARBAGE_COUNT = 1000;
+	const GCDebugInfo& lastInfo = GCManager::Get().GetLastDebugInfo();
+
+	TempObject* root = NewGCObject<TempObject>(GCManager::Get());
+	root->SetRoot(true);
+	TempObject* oldChild = NewGCObject<TempObject>(GCManager::Get());
+	GC_STORE(root, mNext, oldChild);
+
+	// 1. 전체 수집 이후 살아남은 객체는 올드 세대
+	GCManager::Get().Collect();
+	assert(root->IsOld() && oldChild->IsOld());
+	assert(GCManager::Get().GetYoungObjectCount() == 0);
+
+	// 2. 올드 -> 영 참조는 기억 집합을 통해 살아남고, 나머지 영 객체만 수집
+	TempObject* young = NewGCObject<TempObject>(GCManager::Get());
+	GC_STORE(oldChild, mNext, young);
+
+	for (size_t i = 0; i < GARBAGE_COUNT; ++i)
+	{
+		NewGCObject<TempObject>(GCManager::Get());
+	}
+
+	GCManager::Get().CollectMinor();
+	assert(lastInfo.Mode == GCCollectionMode::Minor);
+	assert(lastInfo.TotalObjects == GARBAGE_COUNT + 1);
+	assert(lastInfo.DeletedObjects == GARBAGE_COUNT);
+	assert(lastInfo.RememberedSetSize == 1);
+	assert(!young->IsOld());
+
+	// 3. PromotionAge 번 살아남으면 승격되고 기억 집합에서 빠진다
+	GCManager::Get().CollectMinor();
+	assert(lastInfo.PromotedObjects == 1);
+	assert(lastInfo.RememberedSetSize == 0);
+	assert(young->IsOld());
+	assert(GCManager::Get().GetObjectCount() == 3);
+
+	root->SetRoot(false);
+	GCManager::Get().Collect();
+	assert(lastInfo.RemainingObjects == 0);
+}
+
+class ThrowingObject : public GCObject
+{
+	GENERATE_TYPE_INFO(ThrowingObject)
+
+public:
+	ThrowingObject()
+	{
+		throw std::runtime_error("ThrowingObject");
+	}
+};
+
+void TestGCHeap(void)
+{
+	const size_t OBJECT_COUNT = 100000;
+	const GCDebugInfo& lastInfo = GCManager::Get().GetLastDebugInfo();
+
+	// 1. 같은 크기 클래스의 객체는 페이지를 공유하고, 해제된 슬롯은 다시 사용된다
+	TempObject* first = NewGCObject<TempObject>(GCManager::Get());
+	TempObject* second = NewGCObject<TempObject>(GCManager::Get());
+	assert(GCHeap::GetPage(first) == GCHeap::GetPage(second));
+
+	second->SetRoot(true);
+	GCManager::Get().Collect();
+	assert(lastInfo.DeletedObjects == 1);
+
+	// 변경자 버퍼에 남은 슬롯을 다 쓰고 다시 채울 때 돌려준 슬롯부터 쓴다
+	GCHeap heap;
+	const size_t bufferSlotCount = GCHeap::ALLOCATION_BUFFER_BYTES / GCHeap::GetSizeClassSlotSize(GCHeap::GetSizeClass(sizeof(TempObject)));
+	std::vector<void*> bufferSlots;
+	void* freed = heap.Allocate(sizeof(TempObject));
+	heap.Free(freed);
+
+	for (size_t i = 1; i < bufferSlotCount; ++i)
+	{
+		bufferSlots.push_back(heap.Allocate(sizeof(TempObject)));
+	}
+
+	assert(heap.Allocate(sizeof(TempObject)) == freed);
+	heap.Free(freed);
+
+	for (void* slot : bufferSlots)
+	{
+		heap.Free(slot);
+	}
+
+	// 2. 마크 비트는 페이지 비트맵에 슬롯 단위로 저장된다
+	for (size_t sizeClass = 0; sizeClass < GCHeap::SIZE_CLASS_COUNT; ++sizeClass)
+	{
+		const size_t slotSize = GCHeap::GetSizeClassSlotSize(sizeClass);
+		void* slot0 = heap.Allocate(slotSize);
+		void* slot1 = heap.Allocate(slotSize);
+		for (void* slot : { slot0, slot1 })
+		{
+			const GCPage* page = GCHeap::GetPage(slot);
+			assert(page->GetSlotIndex(slot) == static_cast<size_t>(static_cast<char*>(slot) - page->SlotBegin) / slotSize);
+		}
+
+		assert(GCHeap::Mark(slot1) && !GCHeap::Mark(slot1));
+		assert(GCHeap::IsMarked(slot1) && !GCHeap::IsMarked(slot0));
+		heap.ClearMarkBits();
+		assert(!GCHeap::IsMarked(slot1));
+
+		heap.Free(slot0);
+		heap.Free(slot1);
+	}
+
+	// 3. 큰 객체는 전용 블록에 할당되고 소멸되면 바로 반환된다
+	GCManager::Get().FinishSweep();
+	const size_t pageCount = GCManager::Get().GetHeapPageCount();
+	GameInstance* large = NewGCObject<GameInstance>(GCManager::Get());
+	assert(GCHeap::GetPage(large)->SizeClass == GCHeap::LARGE_SIZE_CLASS);
+	assert(GCManager::Get().GetHeapPageCount() == pageCount + 1);
+
+	second->SetRoot(false);
+	GCManager::Get().Collect();
+	assert(lastInfo.RemainingObjects == 0);
+	GCManager::Get().FinishSweep();
+	assert(GCManager::Get().GetHeapPageCount() < pageCount + 1);
+
+	// 4. 정지 구간에서는 죽은 객체를 찾기만 하고, 소멸은 이후 할당이 나눠서 처리한다
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		NewGCObject<TempObject>(GCManager::Get());
+	}
+
+	GCManager::Get().Collect();
+	assert(lastInfo.DeletedObjects == 1000);
+	assert(lastInfo.PendingSweepObjects == 1000);
+
+	NewGCObject<TempObject>(GCManager::Get());
+	assert(GCManager::Get().GetPendingSweepCount() < 1000);
+
+	GCManager::Get().FinishSweep();
+	assert(GCManager::Get().GetPendingSweepCount() == 0);
+	GCManager::Get().Collect();
+
+	// 5. new/delete 와 GCHeap 의 할당/해제 처리량 비교
+	using namespace std::chrono;
+	std::vector<void*> blocks(OBJECT_COUNT);
+
+	auto mallocStart = high_resolution_clock::now();
+	for (void*& block : blocks)
+	{
+		block = ::operator new(sizeof(TempObject));
+	}
+	auto deleteStart = high_resolution_clock::now();
+	for (void* block : blocks)
+	{
+		::operator delete(block);
+	}
+	auto mallocEnd = high_resolution_clock::now();
+
+	auto heapStart = high_resolution_clock::now();
+	for (void*& block : blocks)
+	{
+		block = heap.Allocate(sizeof(TempObject));
+	}
+	auto heapFreeStart = high_resolution_clock::now();
+	for (void* block : blocks)
+	{
+		heap.Free(block);
+	}
+	auto heapEnd = high_resolution_clock::now();
+
+	std::cout << "[GCHeap] " << OBJECT_COUNT << " alloc/free - new/delete: "
+		<< duration_cast<microseconds>(deleteStart - mallocStart).count() << " + " << duration_cast<microseconds>(mallocEnd - deleteStart).count() << " us, GCHeap: "
+		<< duration_cast<microseconds>(heapFreeStart - heapStart).count() << " + " << duration_cast<microseconds>(heapEnd - heapFreeStart).count() << " us\n";
+
+	// 6. 예약한 힙은 청크 단위로 커밋하고, 통째로 빈 청크는 ReleaseEmptyPages 에서 OS 에 돌려준다
+	assert(lastInfo.ReservedBytes == GCManager::Get().GetReservedBytes() && lastInfo.CommittedBytes > 0);
+
+	GCHeap reservedHeap;
+	assert(reservedHeap.Reserve(64 * GCHeap::RESERVE_CHUNK_SIZE, true));
+	assert(reservedHeap.GetReservedBytes() == 64 * GCHeap::RESERVE_CHUNK_SIZE);
+	assert(reservedHeap.GetCommittedBytes() == 0);
+
+	const size_t largestSlotSize = GCHeap::GetSizeClassSlotSize(GCHeap::SIZE_CLASS_COUNT - 1);
+	const size_t slotsPerChunk = GCHeap::RESERVE_CHUNK_SIZE / largestSlotSize;
+	std::vector<void*> slots(slotsPerChunk * 3);
+
+	for (void*& slot : slots)
+	{
+		slot = reservedHeap.Allocate(largestSlotSize);
+		std::memset(slot, 0xCD, largestSlotSize);
+	}
+
+	assert(reservedHeap.GetCommittedBytes() >= 3 * GCHeap::RESERVE_CHUNK_SIZE);
+
+	for (void* slot : slots)
+	{
+		reservedHeap.Free(slot);
+	}
+
+	// 빈 페이지 하나는 남기므로 첫 청크만 커밋된 채로 남는다
+	reservedHeap.ReleaseEmptyPages();
+	assert(reservedHeap.GetCommittedBytes() == GCHeap::RESERVE_CHUNK_SIZE);
+
+	std::cout << "[GCHeap] reserved " << (reservedHeap.GetReservedBytes() >> 20) << " MB, committed after release: " << (reservedHeap.GetCommittedBytes() >> 20) << " MB\n";
+
+	// 7. 생성자가 던지면 슬롯을 힙에 돌려주고 등록하지 않는다
+	const size_t objectCount = GCManager::Get().GetObjectCount();
+	const size_t allocatedBytes = GCManager::Get().GetAllocatedBytesSinceCollection();
+	bool bThrown = false;
+
+	try
+	{
+		NewGCObject<ThrowingObject>(GCManager::Get());
+	}
+	catch (const std::runtime_error&)
+	{
+		bThrown = true;
+	}
+
+	assert(bThrown);
+	assert(GCManager::Get().GetObjectCount() == objectCount);
+	assert(GCManager::Get().GetAllocatedBytesSinceCollection() == allocatedBytes);
+}
+
+void TestGCRegistry(void)
+{
+	// 1. 청크 경계를 넘는 압축
+	ChunkedVector<int, 4> vector;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		vector.Add(i);
+	}
+
+	assert(vector.GetChunkCount() == 3 && vector.GetChunkLength(2) == 2);
+
+	// 청크마다 짝수만 앞으로 모은 상태 -> { 0, 2, 4, 6, 8 }
+	std::vector<size_t> liveCounts;
+
+	for (size_t chunkIndex = 0; chunkIndex < vector.GetChunkCount(); ++chunkIndex)
+	{
+		int* chunk = vector.GetChunk(chunkIndex);
+		size_t liveCount = 0;
+
+		for (size_t i = 0; i < vector.GetChunkLength(chunkIndex); ++i)
+		{
+			if (chunk[i] % 2 == 0)
+			{
+				chunk[liveCount++] = chunk[i];
+			}
+		}
+
+		liveCounts.push_back(liveCount);
+	}
+
+	vector.CompactChunks(liveCounts);
+	assert(vector.GetSize() == 5);
+
+	for (int i = 0; i < 5; ++i)
+	{
+		assert(vector[i] == i * 2);
+	}
+
+	// 2. 이전 고정 크기(1024 * 128)를 넘는 객체 수
+	const size_t OBJECT_COUNT = 1024 * 128 + 1000;
+	const GCDebugInfo& lastInfo = GCManager::Get().GetLastDebugInfo();
+
+	// 루트는 SetRoot 로 등록된 객체만 루트 집합에 들어간다
+	TempObject* root = NewGCObject<TempObject>(GCManager::Get());
+	root->SetRoot(true);
+	root->SetRoot(true);
+	assert(GCManager::Get().GetRootObjectCount() == 1);
+
+	for (size_t i = 0; i < OBJECT_COUNT; ++i)
+	{
+		TempObject* object = NewGCObject<TempObject>(GCManager::Get());
+
+		if (i % 2 == 0)
+		{
+			GC_WRITE_BARRIER(root, object);
+			root->mRandoms.push_back(object);
+		}
+	}
+
+	assert(GCManager::Get().GetObjectCount() == OBJECT_COUNT + 1);
+
+	GCManager::Get().CollectMultiThread();
+	assert(lastInfo.DeletedObjects == OBJECT_COUNT / 2);
+	assert(lastInfo.RemainingObjects == OBJECT_COUNT / 2 + 1);
+
+	assert(lastInfo.RootObjectCount == 1);
+
+	root->SetRoot(false);
+	assert(GCManager::Get().GetRootObjectCount() == 0);
+	GCManager::Get().CollectMultiThread();
+	assert(lastInfo.RemainingObjects == 0);
+	GCManager::Get().FinishSweep();
+}
+
+void TestGCMarkStack(void)
+{
+	// 1. 가득 찬 스택은 Push 에 실패하고 넘침을 기록
+	GCMarkStack markStack;
+	markStack.Reserve(2);
+	assert(markStack.Push(nullptr, 1) && markStack.Push(nullptr, 2));
+	assert(!markStack.Push(nullptr, 3) && markStack.HasOverflowed());
+
+	GCMarkStack::Entry entry;
+	assert(markStack.Pop(entry) && entry.Depth == 2);
+
+	// 2. FIFO 는 Distance 단계 전에 들어온 값을 내보낸다
+	GCPrefetchQueue<int, 4> prefetchQueue;
+	int evicted = 0;
+
+	for (int i = 0; i < 4; ++i)
+	{
+		assert(!prefetchQueue.Push(i, evicted));
+	}
+
+	assert(prefetchQueue.Push(4, evicted) && evicted == 0);
+
+	// 3. 스택 용량보다 넓은 객체 그래프도 넘침 복구로 모두 마킹된다
+	const size_t CHILD_COUNT = 70000;
+	const GCDebugInfo& lastInfo = GCManager::Get().GetLastDebugInfo();
+
+	TempObject* root = NewGCObject<TempObject>(GCManager::Get());
+	root->SetRoot(true);
+
+	for (size_t i = 0; i < CHILD_COUNT; ++i)
+	{
+		TempObject* child = NewGCObject<TempObject>(GCManager::Get());
+		GC_STORE(child, mNext, NewGCObject<TempObject>(GCManager::Get()));
+		GC_WRITE_BARRIER(root, child);
+		root->mRandoms.push_back(child);
+	}
+
+	GCManager::Get().Collect();
+	assert(lastInfo.MarkStackOverflows > 0);
+	assert(lastInfo.DeletedObjects == 0);
+	assert(lastInfo.RemainingObjects == CHILD_COUNT * 2 + 1);
+
+	// 4. 병렬 마킹에서 큰 참조 배열은 패킷으로 나뉘어 처리된다
+	GCManager::Get().CollectMultiThread();
+
+	const size_t packetSize = lastInfo.MarkPacketSize;
+	assert(packetSize > 0 && packetSize < CHILD_COUNT);
+	assert(lastInfo.MarkPacketCount == (CHILD_COUNT + packetSize - 1) / packetSize);
+	assert(lastInfo.RemainingObjects == CHILD_COUNT * 2 + 1);
+
+	size_t scannedPackets = 0;
+
+	for (const GCWorkerDebugInfo& workerInfo : lastInfo.Workers)
+	{
+		scannedPackets += workerInfo.ScannedPackets;
+	}
+
+	assert(scannedPackets == lastInfo.MarkPacketCount);
+
+	root->SetRoot(false);
+	GCManager::Get().Collect();
+	assert(lastInfo.RemainingObjects == 0);
+	assert(lastInfo.MarkStackOverflows == 0);
+	GCManager::Get().FinishSweep();
+}
+
+class FinalizedObject : public GCObject
+{
+	GENERATE_TYPE_INFO(FinalizedObject)
+	GC_DEFERRED_FINALIZATION
+
+public:
+	~FinalizedObject() override
+	{
+		mFinalizerThreadId = std::this_thread::get_id();
+		++mFinalizedCount;
+	}
+
+	inline static std::atomic<size_t> mFinalizedCount = 0;
+	inline static std::thread::id mFinalizerThreadId;
+};
+
+void TestGCFinalization(void)
+{
+	const size_t OBJECT_COUNT = 100;
+	const GCDebugInfo& lastInfo = GCManager::Get().GetLastDebugInfo();
+
+	static_assert(DeferredFinalization<FinalizedObject>);
+	static_assert(!DeferredFinalization<TempObject>);
+
+	// 표시된 타입만 파이널라이저 스레드로 넘어가고, 나머지는 기존 스윕 경로를 따른다
+	for (size_t i = 0; i < OBJECT_COUNT; ++i)
+	{
+		NewGCObject<FinalizedObject>(GCManager::Get());
+		NewGCObject<TempObject>(GCManager::Get());
+	}
+
+	GCManager::Get().Collect();
+	assert(lastInfo.DeletedObjects == OBJECT_COUNT * 2);
+	assert(lastInfo.DeferredFinalizeObjects == OBJECT_COUNT);
+	assert(lastInfo.PendingSweepObjects == OBJECT_COUNT);
+
+	GCManager::Get().FinishSweep();
+	assert(GCManager::Get().GetPendingFinalizeCount() == 0);
+	assert(FinalizedObject::mFinalizedCount == OBJECT_COUNT);
+	assert(FinalizedObject::mFinalizerThreadId != std::this_thread::get_id());
+}
+
+void TestGCCompaction(void)
+{
+	const size_t OBJECT_COUNT = 20000;
+	const size_t KEEP_INTERVAL = 4;
+	const GCDebugInfo& lastInfo = GCManager::Get().GetLastDebugInfo();
+
+	TempObject* root = NewGCObject<TempObject>(GCManager::Get());
+	root->SetRoot(true);
+
+	for (size_t i = 0; i < OBJECT_COUNT; ++i)
+	{
+		TempObject* object = NewGCObject<TempObject>(GCManager::Get());
+
+		// 4개 중 하나만 남겨 페이지마다 빈 슬롯이 흩어지게 만든다
+		if (i % KEEP_INTERVAL == 0)
+		{
+			GC_WRITE_BARRIER(root, object);
+			root->mRandoms.push_back(object);
+		}
+	}
+
+	const size_t keepCount = root->mRandoms.size();
+
+	for (size_t i = 0; i + 1 < keepCount; ++i)
+	{
+		TempObject* object = static_cast<TempObject*>(root->mRandoms[i]);
+		GC_STORE(object, mNext, root->mRandoms[i + 1]);
+	}
+
+	TempObject* pinned = static_cast<TempObject*>(root->mRandoms[1]);
+	pinned->Pin();
+
+	GCManager::Get().Collect();
+	GCManager::Get().FinishSweep();
+	const size_t pageCount = GCManager::Get().GetHeapPageCount();
+
+	// 1. 사용률이 낮은 페이지의 객체가 옮겨지고 빈 페이지는 반환된다
+	GCManager::Get().CollectCompact();
+	assert(lastInfo.Mode == GCCollectionMode::Compact);
+	assert(lastInfo.DeletedObjects == 0);
+	assert(lastInfo.MovedObjects > 0 && lastInfo.EvacuatedPages > 0);
+	assert(lastInfo.PinnedObjects >= 2);
+	assert(GCManager::Get().GetHeapPageCount() < pageCount);
+	assert(GCManager::Get().GetHeapPageCount() + lastInfo.ReleasedPages == pageCount);
+
+	// 2. 루트와 고정된 객체는 그대로이고, 리플렉션된 참조는 모두 새 주소를 가리킨다
+	assert(root->IsRoot() && root->mRandoms.size() == keepCount);
+	assert(root->mRandoms[1] == pinned && pinned->IsPinned());
+
+	for (size_t i = 0; i + 1 < keepCount; ++i)
+	{
+		TempObject* object = static_cast<TempObject*>(root->mRandoms[i]);
+		assert(object->mNext == root->mRandoms[i + 1]);
+	}
+
+	GCManager::Get().Collect();
+	assert(lastInfo.RemainingObjects == keepCount + 1);
+
+	pinned->Unpin();
+	root->SetRoot(false);
+	GCManager::Get().Collect();
+	assert(lastInfo.RemainingObjects == 0);
+	GCManager::Get().FinishSweep();
+}
+
+class WeakCacheObject : public GCObject
+{
+	GENERATE_TYPE_INFO(WeakCacheObject)
+		PROPERTY(mTarget)
+		PROPERTY(mCache)
+
+public:
+	GCWeakPtr<TempObject> mTarget;
+	std::vector<GCWeakPtr<TempObject>> mCache;
+};
+
+void TestGCWeakPtr(void)
+{
+	const size_t CACHE_SIZE = 100;
+	const GCDebugInfo& lastInfo = GCManager::Get().GetLastDebugInfo();
+
+	const ReferenceMap& referenceMap = WeakCacheObject::StaticTypeInfo().GetReferenceMap();
+	assert(referenceMap.WeakOffsets.size() == 1 && referenceMap.WeakContainers.size() == 1);
+	assert(referenceMap.Offsets.empty() && referenceMap.Containers.empty());
+
+	TempObject* keeper = NewGCObject<TempObject>(GCManager::Get());
+	keeper->SetRoot(true);
+
+	WeakCacheObject* cache = NewGCObject<WeakCacheObject>(GCManager::Get());
+	cache->SetRoot(true);
+	assert(GCManager::Get().GetWeakOwnerCount() == 1);
+
+	// 1. 약한 참조만 있는 객체는 수집되고, 가리키던 GCWeakPtr 는 nullptr 이 된다
+	for (size_t i = 0; i < CACHE_SIZE; ++i)
+	{
+		TempObject* object = NewGCObject<TempObject>(GCManager::Get());
+		cache->mCache.push_back(object);
+
+		if (i % 2 == 0)
+		{
+			GC_WRITE_BARRIER(keeper, object);
+			keeper->mRandoms.push_back(object);
+		}
+	}
+
+	cache->mTarget = NewGCObject<TempObject>(GCManager::Get());
+
+	GCManager::Get().Collect();
+	assert(lastInfo.DeletedObjects == CACHE_SIZE / 2 + 1);
+	assert(lastInfo.ClearedWeakReferences == CACHE_SIZE / 2 + 1);
+	assert(!cache->mTarget && cache->mTarget.Get() == nullptr);
+
+	for (size_t i = 0; i < CACHE_SIZE; ++i)
+	{
+		assert(cache->mCache[i].Get() == (i % 2 == 0 ? keeper->mRandoms[i / 2] : nullptr));
+	}
+
+	// 2. 마이너 수집은 죽은 영 객체만 비우고 올드 객체는 그대로 둔다
+	cache->mTarget = NewGCObject<TempObject>(GCManager::Get());
+	GCManager::Get().CollectMinor();
+	assert(lastInfo.ClearedWeakReferences == 1 && !cache->mTarget);
+	assert(cache->mCache[0].Get() == keeper->mRandoms[0]);
+
+	// 3. 병렬 수집과 압축 후에도 살아있는 대상은 새 주소를 가리킨다
+	keeper->mRandoms.resize(1);
+	GCManager::Get().CollectMultiThread();
+	assert(lastInfo.ClearedWeakReferences == CACHE_SIZE / 2 - 1);
+
+	GCManager::Get().CollectCompact();
+	assert(cache->mCache[0].Get() == keeper->mRandoms[0]);
+	assert(GCManager::Get().GetWeakOwnerCount() == 1);
+
+	keeper->SetRoot(false);
+	cache->SetRoot(false);
+	GCManager::Get().Collect();
+	assert(lastInfo.RemainingObjects == 0);
+	assert(GCManager::Get().GetWeakOwnerCount() == 0);
+	GCManager::Get().FinishSweep();
+}
+
+void TestGCTelemetry(void)
+{
+	const size_t OBJECT_COUNT = 1000;
+	const GCDebugInfo& lastInfo = GCManager::Get().GetLastDebugInfo();
+	const RingBuffer<GCDebugInfo>& history = GCManager::Get().GetDebugInfoHistory();
+
+	// 1. 원형 버퍼는 가득 차면 가장 오래된 원소를 덮어쓴다
+	RingBuffer<int> ring(3);
+
+	for (int i = 0; i < 5; ++i)
+	{
+		ring.Push(i);
+	}
+
+	assert(ring.GetSize() == 3 && ring[0] == 2 && ring.Back() == 4);
+
+	// 2. 수집마다 기록이 남고 리스너가 같은 기록을 받는다
+	std::vector<GCCollectionMode> receivedModes;
+	uint64_t lastCycleIndex = 0;
+
+	GCManager::Get().SetDebugInfoListener([&receivedModes, &lastCycleIndex](const GCDebugInfo& info) {
+		assert(info.CycleIndex == lastCycleIndex + 1 || lastCycleIndex == 0);
+		lastCycleIndex = info.CycleIndex;
+		receivedModes.push_back(info.Mode);
+		});
+
+	TempObject* root = NewGCObject<TempObject>(GCManager::Get());
+	root->SetRoot(true);
+	GC_STORE(root, mNext, NewGCObject<TempObject>(GCManager::Get()));
+
+	for (size_t i = 0; i < OBJECT_COUNT; ++i)
+	{
+		NewGCObject<TempObject>(GCManager::Get());
+	}
+
+	GCManager::Get().CollectMinor();
+	assert(lastInfo.Mode == GCCollectionMode::Minor && lastInfo.DeletedObjects == OBJECT_COUNT);
+	assert(lastInfo.FreedBytes == OBJECT_COUNT * GCHeap::GetAllocationSize(root));
+
+	for (size_t i = 0; i < OBJECT_COUNT; ++i)
+	{
+		NewGCObject<TempObject>(GCManager::Get());
+	}
+
+	GCManager::Get().Collect();
+	assert(lastInfo.DeletedObjects == OBJECT_COUNT && lastInfo.MaxMarkDepth == 2);
+	assert(lastInfo.FreedBytes == OBJECT_COUNT * GCHeap::GetAllocationSize(root));
+	assert(lastInfo.RootScanUs + lastInfo.MarkUs + lastInfo.SweepUs + lastInfo.FinalizeUs <= lastInfo.DurationUs);
+
+	// 3. 병렬 수집은 워커별 스윕 수를 남긴다
+	for (size_t i = 0; i < OBJECT_COUNT; ++i)
+	{
+		NewGCObject<TempObject>(GCManager::Get());
+	}
+
+	GCManager::Get().CollectMultiThread();
+	size_t sweptObjects = 0;
+
+	for (const GCWorkerDebugInfo& workerInfo : lastInfo.Workers)
+	{
+		sweptObjects += workerInfo.SweptObjects;
+	}
+
+	assert(sweptObjects == OBJECT_COUNT);
+
+	assert(receivedModes.size() == 3);
+	assert(receivedModes[0] == GCCollectionMode::Minor && receivedModes[2] == GCCollectionMode::FullMultiThread);
+	assert(history.Back().CycleIndex == lastCycleIndex && history.Back().DeletedObjects == OBJECT_COUNT);
+	assert(history[history.GetSize() - 2].Mode == GCCollectionMode::Full);
+	assert(!GCManager::FormatDebugInfo(lastInfo).empty());
+
+	GCManager::Get().SetDebugInfoListener(nullptr);
+
+	root->SetRoot(false);
+	GCManager::Get().Collect();
+	assert(lastInfo.RemainingObjects == 0);
+	GCManager::Get().FinishSweep();
+}
+
+void TestGCTypeCensus(void)
+{
+	const size_t LIVE_COUNT = 100;
+	const size_t DEAD_COUNT = 300;
+	const TypeInfo& tempType = TempObject::StaticTypeInfo();
+
+	// 1. 꺼져 있으면 집계하지 않는다
+	assert(!GCManager::Get().IsTypeCensusEnabled());
+	GCManager::Get().SetTypeCensusEnabled(true);
+
+	TempObject* root = NewGCObject<TempObject>(GCManager::Get());
+	root->SetRoot(true);
+	const size_t slotSize = GCHeap::GetAllocationSize(root);
+
+	auto allocate = [root, LIVE_COUNT, DEAD_COUNT]() {
+		root->mRandoms.clear();
+
+		for (size_t i = 0; i < LIVE_COUNT; ++i)
+		{
+			root->mRandoms.push_back(NewGCObject<TempObject>(GCManager::Get()));
+		}
+		for (size_t i = 0; i < DEAD_COUNT; ++i)
+		{
+			NewGCObject<TempObject>(GCManager::Get());
+		}
+		};
+
+	// 2. 단일 스레드 전체 수집, 루트 포함 살아있는 수와 해제된 수가 맞아야 한다
+	allocate();
+	GCManager::Get().Collect();
+
+	const GCTypeCensusEntry* entry = GCManager::Get().GetTypeCensus().Find(tempType);
+	assert(entry != nullptr);
+	assert(entry->LiveObjects == LIVE_COUNT + 1 && entry->LiveBytes == (LIVE_COUNT + 1) * slotSize);
+	assert(entry->FreedObjects == DEAD_COUNT && entry->FreedBytes == DEAD_COUNT * slotSize);
+
+	// 3. 병렬 수집은 워커별 집계를 합친 결과가 같아야 한다, 지난번에 살아있던 객체는 이번에 해제된다
+	allocate();
+	GCManager::Get().CollectMultiThread();
+
+	entry = GCManager::Get().GetTypeCensus().Find(tempType);
+	assert(entry != nullptr);
+	assert(entry->LiveObjects == LIVE_COUNT + 1);
+	assert(entry->FreedObjects == DEAD_COUNT + LIVE_COUNT);
+	assert(GCManager::Get().GetTypeCensus().GetEntries().front().Type == &tempType);
+
+	std::ostringstream csv;
+	GCManager::Get().GetTypeCensus().WriteCsv(csv);
+	assert(csv.str().find(tempType.GetName()) != std::string::npos);
+
+	GCManager::Get().SetTypeCensusEnabled(false);
+
+	root->mRandoms.clear();
+	root->SetRoot(false);
+	GCManager::Get().Collect();
+	GCManager::Get().FinishSweep();
+}
+
+void TestGCTriggerPolicy(void)
+{
+	const GCDebugInfo& lastInfo = GCManager::Get().GetLastDebugInfo();
+	const GCTriggerPolicy defaultPolicy = GCManager::Get().GetTriggerPolicy();
+
+	GCManager::Get().Collect();
+	assert(lastInfo.TriggerReason == GCTriggerReason::Manual);
+
+	GCTriggerPolicy policy;
+	policy.MinHeapTriggerBytes = 256 * 1024;
+	policy.YoungAllocationBudget = 32 * 1024;
+	GCManager::Get().SetTriggerPolicy(policy);
+
+	auto allocateUntil = [](auto&& bDone) {
+		while (!bDone())
+		{
+			NewGCObject<TempObject>(GCManager::Get());
+		}
+		};
+
+	// 1. 예산 전에는 아무 일도 하지 않는다
+	for (size_t i = 0; i < 10; ++i)
+	{
+		NewGCObject<TempObject>(GCManager::Get());
+	}
+
+	assert(GCManager::Get().GetAllocatedObjectsSinceCollection() == 10);
+	assert(!GCManager::Get().CollectIfNeeded());
+
+	// 2. 영 세대 할당 예산을 넘으면 마이너 수집
+	allocateUntil([]() { return GCManager::Get().GetAllocatedBytesSinceCollection() >= 32 * 1024; });
+
+	assert(GCManager::Get().CollectIfNeeded());
+	assert(lastInfo.Mode == GCCollectionMode::Minor && lastInfo.TriggerReason == GCTriggerReason::YoungAllocation);
+	assert(lastInfo.AllocatedBytes >= 32 * 1024 && lastInfo.DeletedObjects == lastInfo.AllocatedObjects);
+	assert(GCManager::Get().GetAllocatedBytesSinceCollection() == 0);
+
+	// 3. 힙 한도를 넘으면 전체 수집
+	policy.YoungAllocationBudget = 0;
+	GCManager::Get().SetTriggerPolicy(policy);
+
+	allocateUntil([]() { return GCManager::Get().GetEstimatedHeapBytes() >= GCManager::Get().GetHeapTriggerBytes(); });
+
+	assert(GCManager::Get().CollectIfNeeded());
+	assert(lastInfo.Mode != GCCollectionMode::Minor && lastInfo.TriggerReason == GCTriggerReason::HeapGrowth);
+	assert(GCManager::Get().GetEstimatedHeapBytes() == 0);
+	assert(!GCManager::Get().CollectIfNeeded());
+
+	// 4. 예상 정지 시간이 목표보다 길면 증분 수집으로 나눠 끝까지 이어간다
+	policy.PauseGoalUs = 1;
+	policy.IncrementalSliceUs = 100;
+	GCManager::Get().SetTriggerPolicy(policy);
+
+	allocateUntil([]() { return GCManager::Get().GetEstimatedHeapBytes() >= GCManager::Get().GetHeapTriggerBytes(); });
+
+	assert(GCManager::Get().CollectIfNeeded());
+
+	while (GCManager::Get().IsIncrementalCollecting())
+	{
+		assert(GCManager::Get().CollectIfNeeded());
+	}
+
+	assert(lastInfo.Mode == GCCollectionMode::Incremental && lastInfo.TriggerReason == GCTriggerReason::HeapGrowth);
+	assert(GCManager::Get().GetEstimatedHeapBytes() == 0);
+
+	GCManager::Get().SetTriggerPolicy(defaultPolicy);
+	GCManager::Get().Collect();
+	assert(lastInfo.TriggerReason == GCTriggerReason::Manual && lastInfo.RemainingObjects == 0);
+	GCManager::Get().FinishSweep();
+}
+
+void TestGCConcurrent(void)
+{
+	const size_t TEST_INSTANCE_COUNT = 10;
+	const int64_t BUDGET_US = 1000;
+	GameInstance* gameInstances[TEST_INSTANCE_COUNT];
+	const GCDebugInfo& lastInfo = GCManager::Get().GetLastDebugInfo();
+
+	for (size_t i = 0; i < TEST_INSTANCE_COUNT; ++i)
+	{
+		gameInstances[i] = NewGCObject<GameInstance>(GCManager::Get());
+		gameInstances[i]->SetRoot(true);
+		gameInstances[i]->CreateReferenceChain();
+	}
+
+	for (size_t i = 0; i < TEST_INSTANCE_COUNT; ++i)
+	{
+		gameInstances[i]->ConnectRandom(gameInstances[0]);
+
+		if (i > 0)
+		{
+			gameInstances[i]->ConnectRandom(gameInstances[i - 1]);
+		}
+		if (i + 1 < TEST_INSTANCE_COUNT)
+		{
+			gameInstances[i]->ConnectRandom(gameInstances[i + 1]);
+		}
+	}
+
+	// 1. 같은 그래프에서 병렬 수집의 정지 시간을 기준으로 잰다
+	GCManager::Get().CollectMultiThread();
+	assert(lastInfo.DeletedObjects == 0);
+	const int64_t parallelPauseUs = lastInfo.DurationUs;
+
+	// 2. 배경 마킹 중에 참조를 끊고 새 객체를 연결해도 스냅샷 시점에 살아있던 객체와 새 객체는 살아남는다
+	GCManager::Get().CollectConcurrent(BUDGET_US);
+	assert(GCManager::Get().GetIncrementalPhase() == GCPhase::ConcurrentMark);
+
+	for (size_t i = TEST_INSTANCE_COUNT / 2; i < TEST_INSTANCE_COUNT; ++i)
+	{
+		GC_WRITE_BARRIER(gameInstances[i], nullptr);
+		gameInstances[i]->ReleaseObjectReference();
+	}
+
+	TempObject* created = NewGCObject<TempObject>(GCManager::Get());
+	const Property* nextProperty = TempObject::StaticTypeInfo().GetProperty("mNext");
+	TempObject* head = static_cast<TempObject*>(NewGCObject<TempObject>(GCManager::Get()));
+	head->SetRoot(true);
+	nextProperty->Set<GCObject*>(head, created);
+
+	while (GCManager::Get().IsIncrementalCollecting())
+	{
+		GCManager::Get().CollectConcurrent(BUDGET_US);
+	}
+
+	assert(lastInfo.Mode == GCCollectionMode::Concurrent);
+	assert(lastInfo.DeletedObjects == 0);
+	assert(lastInfo.RemainingObjects == 100000 + TEST_INSTANCE_COUNT + 2);
+	assert(lastInfo.SliceCount >= 2 && lastInfo.RootScanUs + lastInfo.RemarkUs <= lastInfo.DurationUs);
+
+	std::cout << "[GC] 100k graph - CollectMultiThread pause: " << parallelPauseUs
+		<< " us, concurrent max pause: " << lastInfo.SlicePauseMaxUs
+		<< " us (root snapshot " << lastInfo.RootScanUs << " us, remark " << lastInfo.RemarkUs
+		<< " us, background mark " << lastInfo.ConcurrentMarkUs << " us)\n";
+
+	// 3. 모든 참조를 끊으면 다음 사이클에서 전부 수집되고, 전체 수집이 더 지울 것이 없어야 한다
+	for (size_t i = 0; i < TEST_INSTANCE_COUNT / 2; ++i)
+	{
+		gameInstances[i]->ReleaseObjectReference();
+	}
+
+	while (true)
+	{
+		GCManager::Get().CollectConcurrent(BUDGET_US);
+
+		if (!GCManager::Get().IsIncrementalCollecting())
+		{
+			break;
+		}
+	}
+
+	const size_t remainingObjects = lastInfo.RemainingObjects;
+	assert(lastInfo.DeletedObjects == 100000);
+
+	GCManager::Get().Collect();
+	assert(lastInfo.DeletedObjects == 0 && lastInfo.RemainingObjects == remainingObjects);
+	assert(head->mNext == created);
+
+	// 4. 마킹 도중 전체 수집을 부르면 배경 마킹을 멈추고 처음부터 수집한다
+	GCManager::Get().CollectConcurrent(BUDGET_US);
+	GCManager::Get().Collect();
+	assert(!GCManager::Get().IsIncrementalCollecting() && lastInfo.Mode == GCCollectionMode::Full);
+
+	head->SetRoot(false);
+	for (size_t i = 0; i < TEST_INSTANCE_COUNT; ++i)
+	{
+		gameInstances[i]->SetRoot(false);
+	}
+
+	GCManager::Get().Collect();
+	assert(lastInfo.RemainingObjects == 0);
+	GCManager::Get().FinishSweep();
+}
+
+void TestGCThreadAllocation(void)
+{
+	const size_t THREAD_COUNT = 4;
+	const size_t CHAIN_LENGTH = 10000;
+	const size_t GARBAGE_COUNT = 1000;
+	const GCDebugInfo& lastInfo = GCManager::Get().GetLastDebugInfo();
+
+	// 스레드마다 자기 객체끼리만 연결한 체인을 만들고 머리를 돌려준다
+	auto createChain = [](TempObject*& outHead) {
+		TempObject* head = NewGCObject<TempObject>(GCManager::Get());
+		TempObject* tail = head;
+
+		for (size_t i = 1; i < CHAIN_LENGTH; ++i)
+		{
+			TempObject* next = NewGCObject<TempObject>(GCManager::Get());
+			GC_STORE(tail, mNext, next);
+			tail = next;
+
+			if (i % (CHAIN_LENGTH / GARBAGE_COUNT) == 0)
+			{
+				NewGCObject<TempObject>(GCManager::Get());
+			}
+		}
+
+		outHead = head;
+		};
+
+	// 1. 다른 스레드에서 만든 객체는 다음 수집 시작에서 합쳐지고, 변경자 스레드가 루트로 잡은 체인만 살아남는다
+	TempObject* heads[THREAD_COUNT] = {};
+	std::vector<std::thread> threads;
+
+	for (size_t i = 0; i < THREAD_COUNT; ++i)
+	{
+		threads.emplace_back(createChain, std::ref(heads[i]));
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	threads.clear();
+	assert(GCManager::Get().GetObjectCount() == 0);
+
+	// 먼저 끝난 스레드의 캐시를 뒤에 시작한 스레드가 가져갔을 수 있다
+	const size_t threadCacheCount = GCManager::Get().GetThreadCacheCount();
+	assert(threadCacheCount >= 1 && threadCacheCount <= THREAD_COUNT);
+
+	for (TempObject* head : heads)
+	{
+		head->SetRoot(true);
+	}
+
+	GCManager::Get().Collect();
+	assert(lastInfo.AllocatedObjects == THREAD_COUNT * (CHAIN_LENGTH + GARBAGE_COUNT - 1));
+	assert(lastInfo.DeletedObjects == THREAD_COUNT * (GARBAGE_COUNT - 1));
+	assert(lastInfo.RemainingObjects == THREAD_COUNT * CHAIN_LENGTH);
+
+	// 2. 끝난 스레드의 캐시는 다음 스레드가 다시 쓴다
+	for (size_t i = 0; i < 2; ++i)
+	{
+		std::thread([]() { NewGCObject<TempObject>(GCManager::Get()); }).join();
+	}
+
+	assert(GCManager::Get().GetThreadCacheCount() == threadCacheCount);
+
+	// 3. 증분 마킹 중 다른 스레드가 만든 객체는 검은색으로 시작하고,
+	//    그 객체에 이전 사이클에서 만든 객체를 연결하면 쓰기 장벽이 살려 둔다
+	TempObject* older = nullptr;
+	std::thread([&older]() { older = NewGCObject<TempObject>(GCManager::Get()); }).join();
+
+	GCManager::Get().CollectIncremental(1);
+	assert(GCManager::Get().GetIncrementalPhase() == GCPhase::Mark);
+
+	TempObject* newer = nullptr;
+	std::thread([&newer, older]() {
+		newer = NewGCObject<TempObject>(GCManager::Get());
+		GC_STORE(newer, mNext, older);
+		}).join();
+
+	newer->SetRoot(true);
+
+	while (GCManager::Get().IsIncrementalCollecting())
+	{
+		GCManager::Get().CollectIncremental(1000);
+	}
+
+	assert(lastInfo.DeletedObjects == 2);
+
+	GCManager::Get().Collect();
+	assert(lastInfo.DeletedObjects == 0 && lastInfo.RemainingObjects == THREAD_COUNT * CHAIN_LENGTH + 2);
+	assert(newer->mNext == older);
+
+	newer->SetRoot(false);
+	for (TempObject* head : heads)
+	{
+		head->SetRoot(false);
+	}
+
+	GCManager::Get().Collect();
+	assert(lastInfo.RemainingObjects == 0);
+	GCManager::Get().FinishSweep();
+}
+
+void TestGCSafepoint(void)
+{
+	const size_t THREAD_COUNT = 3;
+	const GCDebugInfo& lastInfo = GCManager::Get().GetLastDebugInfo();
+
+	std::atomic<bool> bStop = false;
+	std::atomic<size_t> registeredCount = 0;
+	std::atomic<size_t> iterationCount = 0;
+	std::vector<std::thread> threads;
+
+	// 1. 등록한 스레드는 루프마다 세이프포인트를 확인하며 쓰레기 객체를 만든다
+	for (size_t i = 0; i < THREAD_COUNT; ++i)
+	{
+		threads.emplace_back([&bStop, &registeredCount, &iterationCount]() {
+			GCManager::Get().RegisterThread();
+			registeredCount.fetch_add(1);
+
+			while (!bStop.load(std::memory_order_relaxed))
+			{
+				TempObject* object = NewGCObject<TempObject>(GCManager::Get());
+				GC_STORE(object, mNext, NewGCObject<TempObject>(GCManager::Get()));
+				iterationCount.fetch_add(1, std::memory_order_relaxed);
+
+				GCManager::Safepoint();
+			}
+
+			GCManager::Get().UnregisterThread();
+			});
+	}
+
+	// 2. 세이프 구간의 스레드는 폴링하지 않아도 수집이 기다리지 않는다
+	std::atomic<bool> bWake = false;
+	threads.emplace_back([&bWake, &registeredCount]() {
+		GCManager::Get().RegisterThread();
+		GCManager::Get().EnterSafeRegion();
+		registeredCount.fetch_add(1);
+
+		while (!bWake.load())
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		GCManager::Get().LeaveSafeRegion();
+		});
+
+	while (registeredCount.load() != THREAD_COUNT + 1)
+	{
+		std::this_thread::yield();
+	}
+
+	// 3. 수집이 끝났다고 알리는 리스너는 아직 정지 구간 안이므로 등록 스레드가 움직이지 않는다
+	bool bParked = true;
+
+	GCManager::Get().SetDebugInfoListener([&iterationCount, &bParked](const GCDebugInfo&) {
+		const size_t before = iterationCount.load();
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		bParked &= (iterationCount.load() == before);
+		});
+
+	for (size_t i = 0; i < 5; ++i)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		GCManager::Get().Collect();
+		assert(lastInfo.SafepointThreadCount == THREAD_COUNT);
+		assert(lastInfo.TimeToSafepointUs >= 0);
+	}
+
+	GCManager::Get().CollectIncremental(1);
+	while (GCManager::Get().IsIncrementalCollecting())
+	{
+		GCManager::Get().CollectIncremental(1000);
+	}
+
+	assert(lastInfo.SafepointThreadCount == THREAD_COUNT);
+	assert(bParked);
+
+	std::cout << "[GC] time to safepoint with " << THREAD_COUNT << " polling threads: " << lastInfo.TimeToSafepointUs << " us\n";
+
+	GCManager::Get().SetDebugInfoListener(nullptr);
+
+	bStop.store(true);
+	bWake.store(true);
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	// 4. 해제한 스레드는 기다리지 않는다
+	GCManager::Get().Collect();
+	assert(lastInfo.SafepointThreadCount == 0 && lastInfo.RemainingObjects == 0);
+	GCManager::Get().FinishSweep();
+}
+
+void TestGCRoot(void)
+{
+	const size_t GARBAGE_COUNT = 2000;
+	const size_t CHAIN_LENGTH = 256;
+	const GCDebugInfo& lastInfo = GCManager::Get().GetLastDebugInfo();
+
+	// 1. GCRoot 가 잡은 객체와 그 자식은 루트 플래그 없이 살아남는다
+	{
+		GCRoot<TempObject> root(NewGCObject<TempObject>(GCManager::Get()));
+		GC_STORE(root.Get(), mNext, NewGCObject<TempObject>(GCManager::Get()));
+		NewGCObject<TempObject>(GCManager::Get());
+
+		GCManager::Get().Collect();
+		assert(!root->IsRoot() && GCManager::Get().GetRootObjectCount() == 0);
+		assert(lastInfo.RootObjectCount == 1 && lastInfo.StackRootCount == 1);
+		assert(lastInfo.RemainingObjects == 2);
+
+		// 2. 안쪽 스코프의 GCRoot 는 스코프를 나가면 더 이상 루트가 아니다
+		{
+			GCRoot<TempObject> inner(NewGCObject<TempObject>(GCManager::Get()));
+			GCRoot<TempObject> empty;
+
+			GCManager::Get().CollectMultiThread();
+			assert(lastInfo.StackRootCount == 2 && lastInfo.RemainingObjects == 3);
+
+			// 마이너 수집에서도 영 객체의 루트가 된다
+			empty = NewGCObject<TempObject>(GCManager::Get());
+			GCManager::Get().CollectMinor();
+			assert(lastInfo.DeletedObjects == 0 && GCManager::Get().GetObjectCount() == 4);
+		}
+
+		GCManager::Get().Collect();
+		assert(lastInfo.StackRootCount == 1 && lastInfo.RemainingObjects == 2);
+
+		// 3. 증분 마킹 도중 GCRoot 로 옮겨 잡은 객체는 원래 참조가 지워져도 살아남는다
+		//    마킹이 닿기 전에 끊기도록 긴 사슬의 끝 객체를 옮긴다
+		TempObject* previous = nullptr;
+		TempObject* tail = static_cast<TempObject*>(root->mNext);
+
+		for (size_t i = 0; i < CHAIN_LENGTH; ++i)
+		{
+			previous = tail;
+			tail = NewGCObject<TempObject>(GCManager::Get());
+			GC_STORE(previous, mNext, tail);
+		}
+
+		GCManager::Get().CollectIncremental(0);
+		assert(GCManager::Get().IsIncrementalCollecting());
+		{
+			GCRoot<TempObject> moved(tail);
+			GC_STORE(previous, mNext, nullptr);
+
+			while (GCManager::Get().IsIncrementalCollecting())
+			{
+				GCManager::Get().CollectIncremental(1000);
+			}
+
+			assert(lastInfo.RemainingObjects == CHAIN_LENGTH + 2);
+
+			GC_STORE(root.Get(), mNext, nullptr);
+			GCManager::Get().CollectConcurrent(1000);
+			while (GCManager::Get().IsIncrementalCollecting())
+			{
+				GCManager::Get().CollectConcurrent(1000);
+			}
+
+			assert(lastInfo.StackRootCount == 2 && lastInfo.RemainingObjects == 2);
+		}
+
+		GCManager::Get().Collect();
+		assert(lastInfo.RemainingObjects == 1);
+	}
+
+	GCManager::Get().Collect();
+	assert(lastInfo.StackRootCount == 0 && lastInfo.RemainingObjects == 0);
+	GCManager::Get().FinishSweep();
+
+	// 4. 압축 수집은 GCRoot 가 잡은 객체를 고정하지 않고 옮긴 뒤 슬롯을 새 주소로 바꾼다
+	{
+		for (size_t i = 0; i < GARBAGE_COUNT; ++i)
+		{
+			NewGCObject<TempObject>(GCManager::Get());
+		}
+
+		GCRoot<TempObject> root(NewGCObject<TempObject>(GCManager::Get()));
+		TempObject* child = NewGCObject<TempObject>(GCManager::Get());
+		GC_STORE(root.Get(), mNext, child);
+		GC_STORE(child, mPrev, root.Get());
+
+		for (size_t i = 0; i < GARBAGE_COUNT; ++i)
+		{
+			NewGCObject<TempObject>(GCManager::Get());
+		}
+
+		TempObject* before = root.Get();
+
+		GCManager::Get().CollectCompact();
+		assert(lastInfo.PinnedObjects == 0 && lastInfo.MovedObjects == 2);
+		assert(root.Get() != before);
+		assert(static_cast<TempObject*>(root->mNext)->mPrev == root.Get());
+	}
+
+	GCManager::Get().Collect();
+	assert(lastInfo.RemainingObjects == 0);
+	GCManager::Get().FinishSweep();
+
+	// 5. 등록한 스레드의 GCRoot 는 그 스레드가 세이프포인트에 멈춰 있는 동안 수집기가 읽는다
+	std::atomic<bool> bReady = false;
+	std::atomic<bool> bStop = false;
+
+	std::thread thread([&bReady, &bStop]() {
+		GCManager::Get().RegisterThread();
+		{
+			GCRoot<TempObject> root(NewGCObject<TempObject>(GCManager::Get()));
+			GC_STORE(root.Get(), mNext, NewGCObject<TempObject>(GCManager::Get()));
+			bReady.store(true);
+
+			while (!bStop.load(std::memory_order_relaxed))
+			{
+				GCManager::Safepoint();
+				std::this_thread::yield();
+			}
+
+			assert(root->mNext != nullptr);
+		}
+		GCManager::Get().UnregisterThread();
+		});
+
+	while (!bReady.load())
+	{
+		std::this_thread::yield();
+	}
+
+	GCManager::Get().Collect();
+	assert(lastInfo.SafepointThreadCount == 1 && lastInfo.StackRootCount == 1);
+	assert(lastInfo.RemainingObjects == 2);
+
+	bStop.store(true);
+	thread.join();
+
+	GCManager::Get().Collect();
+	assert(lastInfo.RemainingObjects == 0);
+	GCManager::Get().FinishSweep();
+}
+
+void TestGCRegion(void)
+{
+	const size_t OBJECT_COUNT = 10000;
+	const GCDebugInfo& lastInfo = GCManager::Get().GetLastDebugInfo();
+
+	GCManager::Get().FinishSweep();
+	const size_t finalizedCount = FinalizedObject::mFinalizedCount;
+	const size_t allocatedBytes = GCManager::Get().GetAllocatedBytesSinceCollection();
+
+	TempObject* kept = nullptr;
+	{
+		GCRegion region(GCManager::Get());
+
+		// 1. 영역 객체는 힙에 등록되지 않고, 수집이 따라가거나 지우지 않는다
+		TempObject* head = NewGCObject<TempObject>(region);
+		TempObject* tail = head;
+
+		for (size_t i = 1; i < OBJECT_COUNT; ++i)
+		{
+			TempObject* object = NewGCObject<TempObject>(region);
+			GC_STORE(tail, mNext, object);
+			tail = object;
+		}
+
+		NewGCObject<FinalizedObject>(region);
+		assert(GCHeap::IsRegion(head) && region.Contains(tail));
+		assert(region.GetObjectCount() == OBJECT_COUNT + 1);
+		assert(GCManager::Get().GetObjectCount() == 0 && GCManager::Get().GetAllocatedBytesSinceCollection() == allocatedBytes);
+		assert(GCManager::Get().GetRegionPageCount() > 1);
+
+		GCManager::Get().Collect();
+		assert(lastInfo.TotalObjects == 0 && lastInfo.RootObjectCount == 0);
+
+		// 영역 객체는 힙 객체를 가리킬 수 있다, 힙 객체는 다른 경로로 살아 있어야 한다
+		TempObject* heapObject = NewGCObject<TempObject>(GCManager::Get());
+		heapObject->SetRoot(true);
+		GC_STORE(head, mPrev, heapObject);
+
+		// 2. Reset 은 소멸자를 한 번씩 부르고 페이지 하나만 남긴다, 돌려준 페이지는 힙이 들고 있다
+		const size_t regionPageCount = GCManager::Get().GetRegionPageCount();
+		region.Reset();
+		assert(region.GetObjectCount() == 0 && region.GetAllocatedBytes() == 0);
+		assert(FinalizedObject::mFinalizedCount == finalizedCount + 1);
+
+		TempObject* reused = NewGCObject<TempObject>(region);
+		assert(region.Contains(reused) && !region.Contains(head));
+		assert(GCManager::Get().GetRegionPageCount() == regionPageCount);
+
+		// 3. 한 페이지를 넘는 객체는 전용 블록에 둔다
+		GameInstance* large = NewGCObject<GameInstance>(region);
+		assert(region.Contains(large) && GCHeap::GetPage(large)->BlockSize > GCHeap::PAGE_SIZE);
+
+		// 4. Promote 한 객체는 이동 생성으로 힙에 옮겨지고 일반 객체처럼 수집된다
+		TempObject* promoted = NewGCObject<TempObject>(region);
+		GC_STORE(promoted, mNext, heapObject);
+		promoted->mRandoms.push_back(heapObject);
+
+		kept = region.Promote(promoted);
+		assert(!GCHeap::IsRegion(kept) && !region.Contains(kept));
+		assert(kept->mNext == heapObject && kept->mRandoms.size() == 1);
+		assert(region.GetObjectCount() == 2 && GCManager::Get().GetObjectCount() == 2);
+
+		kept->SetRoot(true);
+		heapObject->SetRoot(false);
+	}
+
+	// 5. 영역이 끝나면 페이지는 다음 영역이 다시 쓰도록 힙에 남는다
+	const size_t regionPageCount = GCManager::Get().GetRegionPageCount();
+	{
+		GCRegion region(GCManager::Get());
+		NewGCObject<TempObject>(region);
+		assert(GCManager::Get().GetRegionPageCount() == regionPageCount);
+	}
+
+	GCManager::Get().Collect();
+	assert(lastInfo.RemainingObjects == 2 && kept->mRandoms[0] == kept->mNext);
+
+	kept->SetRoot(false);
+	GCManager::Get().Collect();
+	assert(lastInfo.RemainingObjects == 0);
+	GCManager::Get().FinishSweep();
+
+	// 6. 프레임마다 만들고 버리는 객체의 비용 비교
+	using namespace std::chrono;
+
+	auto heapStart = high_resolution_clock::now();
+	for (size_t i = 0; i < OBJECT_COUNT; ++i)
+	{
+		NewGCObject<TempObject>(GCManager::Get());
+	}
+	GCManager::Get().Collect();
+	GCManager::Get().FinishSweep();
+	auto heapUs = duration_cast<microseconds>(high_resolution_clock::now() - heapStart).count();
+
+	auto regionStart = high_resolution_clock::now();
+	{
+		GCRegion region(GCManager::Get());
+
+		for (size_t i = 0; i < OBJECT_COUNT; ++i)
+		{
+			NewGCObject<TempObject>(region);
+		}
+	}
+	auto regionUs = duration_cast<microseconds>(high_resolution_clock::now() - regionStart).count();
+
+	std::cout << "[GCRegion] " << OBJECT_COUNT << " frame temporaries - heap + collect: " << heapUs << " us, region: " << regionUs << " us\n";
+}
+
 class MoveablePerson : public Person
 {
 	GENERATE_TYPE_INFO(MoveablePerson)